@@ -8,6 +8,7 @@
 		-# Test 202 Draw pixel
 		-# Test 203 Draw lines
 		-# Test 204 Draw shapes
+		-# Test 205 Draw polygons, ellipses, arcs and curves
 */
 
 
@@ -50,6 +51,10 @@ void testDrawTriangle(void);
 void testFillTriangle(void);
 void testDrawRoundRect(void);
 void testFillRoundRect(void);
+void testPolygon(void);
+void testEllipse(void);
+void testArc(void);
+void testBezier(void);
 
 // ************  MAIN ***************
 
@@ -73,6 +78,12 @@ int main(int argc, char **argv)
 	testDrawTriangle();
 	testFillTriangle();
 
+	std::cout <<"Test 205 Draw polygons, ellipses, arcs and curves" << std::endl;
+	testPolygon();
+	testEllipse();
+	testArc();
+	testBezier();
+
 	EndTests();
 	return 0;
 }
@@ -161,6 +172,36 @@ void testFillRoundRect(void) {
 	screenReset();
 }
 
+void testPolygon(void) {
+	LCD_Point_t arrow[7] = {{10, 20}, {50, 20}, {50, 8}, {75, 24}, {50, 40}, {50, 28}, {10, 28}};
+	myLCD.fillPolygon(arrow, 7, LCD_BLACK);
+	screenReset();
+	LCD_Point_t star[5] = {{42, 2}, {55, 44}, {20, 18}, {64, 18}, {29, 44}};
+	myLCD.drawPolygon(star, 5, LCD_BLACK);
+	screenReset();
+}
+
+void testEllipse(void) {
+	myLCD.drawEllipse(20, 24, 18, 10, LCD_BLACK);
+	myLCD.fillEllipse(64, 24, 10, 20, LCD_BLACK);
+	screenReset();
+}
+
+void testArc(void) {
+	// a dial , the ring segment shows the value and the needle points at it
+	myLCD.drawArc(42, 30, 26, -120, 120, LCD_BLACK);
+	myLCD.fillArc(42, 30, 22, 16, -120, 30, LCD_BLACK);
+	LCD_Point_t needle[3] = {{40, 29}, {44, 31}, {50, 16}};
+	myLCD.fillPolygon(needle, 3, LCD_BLACK);
+	screenReset();
+}
+
+void testBezier(void) {
+	myLCD.drawBezier({2, 45}, {42, -30}, {82, 45}, LCD_BLACK);
+	myLCD.drawBezier({2, 24}, {30, 0}, {54, 48}, {82, 24}, LCD_BLACK);
+	screenReset();
+}
+
 void testDrawRect(void) {
 	myLCD.drawRect(20, 15, 20, 15, LCD_BLACK);
 	screenReset();
@@ -6,6 +6,7 @@
 	@details https://github.com/gavinlyonsrepo/NOKIA_5110_RPI
 	@test
 		-# Test 901 FPS test (frame rate per second)
+		-# Test 902 FPS test , text fields and dirty update , only changed bytes sent
 */
 
 // Test results RPI3, Frame rate per Second, FPS. v1.3
@@ -24,6 +25,7 @@
 #include <iostream> // for std::cout
 #include <time.h>
 #include "NOKIA_5110_RPI.hpp" // PCD8544 controller driver
+#include "NOKIA_5110_Widgets.hpp" // Text field widget
 #include "Bitmap_data.hpp" // Data for bitmap tests
 
 // *********** Test setup  **************
@@ -51,6 +53,8 @@ NOKIA_5110_RPI myLCD(RST_LCD, DC_LCD, SPICLK_FREQ, SPI_CE_PIN);
 bool Setup(void);
 void myLoop(void);
 void display_buffer(long , int );
+void display_dirty(long , int );
+uint16_t framesPerSecond(long);
 void EndTests(void);
 static uint64_t counter( void );
 
@@ -99,19 +103,30 @@ void EndTests(void)
 
 void myLoop() {
 
+	std::cout << "Test 901 FPS test" << std::endl;
+	long framerate = 0;
 	while (count < 10000)
 	{
-		static long framerate = 0;
 		display_buffer(framerate, count);
 		framerate++;
 		count++;
 	}
 
+	std::cout << "Test 902 FPS test, dirty update" << std::endl;
+	count = 0;
+	myLCD.LCDdisplayClear();
+	while (count < 10000)
+	{
+		display_dirty(framerate, count);
+		framerate++;
+		count++;
+	}
+
 }
 
-void display_buffer(long currentFramerate, int count)
+// Returns the frames in the last whole second
+uint16_t framesPerSecond(long currentFramerate)
 {
-	// Values to count frame rate per second
 	static long lastFramerate = 0;
 	static uint16_t fps;
 	uint64_t currentCounter = counter();
@@ -123,7 +138,13 @@ void display_buffer(long currentFramerate, int count)
 		previousCounter = currentCounter;
 		colour = !colour;
 	}
-	
+	return fps;
+}
+
+void display_buffer(long currentFramerate, int count)
+{
+	uint16_t fps = framesPerSecond(currentFramerate);
+
 	// *****
 	// Code to speed test here
 	myLCD.LCDdisplayClear();
@@ -148,6 +169,38 @@ void display_buffer(long currentFramerate, int count)
 	myLCD.LCDdisplayUpdate();
 }
 
+// The same screen , the static text is drawn once , the numbers are text fields
+// that redraw only the changed characters , and only changed bytes are sent
+void display_dirty(long currentFramerate, int count)
+{
+	static NOKIA_5110_TextField countField({0, 20, 48, 8}, &LCDFontTable[LCDFont_Default]);
+	static NOKIA_5110_TextField fpsField({0, 30, 48, 8}, &LCDFontTable[LCDFont_Default]);
+	uint16_t fps = framesPerSecond(currentFramerate);
+	char text[16];
+
+	// *****
+	if (count == 0)
+	{
+		myLCD.setCursor(0, 0);
+		myLCD.print("Nokia");
+		myLCD.setCursor(0, 10);
+		myLCD.print("G Lyons");
+		myLCD.setCursor(0, 40);
+		myLCD.print(myLCD.LCDLibVerNumGet());
+		countField.invalidate();
+		fpsField.invalidate();
+	}
+	snprintf(text, sizeof(text), "%d", count);
+	countField.setText(myLCD, text);
+	snprintf(text, sizeof(text), "%u fps", fps);
+	fpsField.setText(myLCD, text);
+
+	myLCD.fillRect(60, 1, 20, 20, colour);
+	myLCD.fillCircle(60, 35, 10, !colour);
+	// *****
+	myLCD.LCDdisplayUpdateDirty();
+}
+
 // This func returns nano-seconds as a 64-bit unsigned number, 
 // monotonically increasing, probably since system boot.
 // The actual resolution looks like microseconds. returns nanoseconds
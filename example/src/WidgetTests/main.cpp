@@ -0,0 +1,234 @@
+/*!
+	@file: example/src/WidgetTests/main.cpp
+	@brief Description library test file, carries out series of widget and canvas tests , HW SPI
+			PCD8544 Nokia 5110 SPI LCD display Library
+	@author Gavin Lyons.
+	@details https://github.com/gavinlyonsrepo/NOKIA_5110_RPI
+	@test
+		-# Test 501 Text field and dirty update
+		-# Test 502 Console
+		-# Test 503 Ticker
+		-# Test 504 Strip chart and bar
+		-# Test 505 Plot of a large data set
+		-# Test 506 Canvas and compositor
+*/
+
+
+// ************ libraries **************
+#include <bcm2835.h> // for SPI, GPIO and delays. airspayce.com/mikem/bcm2835/index.html
+#include <iostream> // for std::cout
+#include <math.h>
+#include <vector>
+#include "NOKIA_5110_RPI.hpp" // PCD8544 controller driver
+#include "NOKIA_5110_Widgets.hpp" // Text field, console, ticker, chart and bar widgets
+#include "NOKIA_5110_Canvas.hpp" // Off screen canvas and compositor
+
+// *********** Test setup Defines **************
+#define TEST_DELAY1 1000
+#define TEST_DELAY2 2000
+#define TEST_DELAY5 5000
+
+// **************** GPIO ***************
+#define RST_LCD 25
+#define DC_LCD 24
+
+#define inverse  false // set to true to invert display pixel color
+#define contrast 0xB2 // default is 0xBF set in LCDinit, Try 0xB1 <-> 0xBF if your display is too dark/dim
+#define bias 0x13 // LCD bias mode 1:48: Try 0x12 or 0x13 or 0x14
+
+const uint32_t SPICLK_FREQ = 64; // Spi clock divider see bcm2835SPIClockDivider enum bcm2835
+const uint8_t SPI_CE_PIN = 0; // which HW SPI chip enable pin to use,  0 or 1
+
+NOKIA_5110_RPI myLCD(RST_LCD, DC_LCD, SPICLK_FREQ, SPI_CE_PIN);
+
+// ************ Function Headers ****************
+bool Setup(void);
+void screenReset(void);
+void EndTests(void);
+
+void testTextField(void);
+void testConsole(void);
+void testTicker(void);
+void testChartBar(void);
+void testPlot(void);
+void testCompositor(void);
+
+// ************  MAIN ***************
+
+int main(int argc, char **argv)
+{
+	if(!Setup()) return -1;
+
+	testTextField();
+	testConsole();
+	testTicker();
+	testChartBar();
+	testPlot();
+	testCompositor();
+
+	EndTests();
+	return 0;
+}
+// ********* End OF MAIN ********
+
+
+// ******** Function Space *************
+
+// Initialize the device
+bool Setup(void)
+{
+	std::cout << "LCD Start"  << std::endl;
+	if(!bcm2835_init())
+	{
+		std::cout<< "Error 1201 : Setup :Problem with init bcm2835 library" << std::endl;
+		return false;
+	}else{
+		std::cout<< "bcm2835 library version : " << bcm2835_version() << std::endl;
+	}
+	bcm2835_delay(250);
+	if(!myLCD.LCDBegin(inverse, contrast, bias))
+	{
+		std::cout<< "Error 1202: Setup : bcm2835_spi_begin :Cannot start spi, Running as root?" << std::endl;
+		bcm2835_close(); // Close the bcm2835 library
+		return false;
+	}
+	std::cout<< "Nokia 5110 library version : " << myLCD.LCDLibVerNumGet() << std::endl;
+	bcm2835_delay(250);
+	myLCD.LCDdisplayClear();
+	return true;
+}
+
+void EndTests(void)
+{
+	myLCD.LCDSPIoff(); //Stop the hardware SPI
+	myLCD.LCDPowerDown(); // Power down device
+	bcm2835_close(); // Close the bcm2835 library
+	std::cout << "LCD End" << std::endl;
+}
+
+// A counting clock, only the changed digits are redrawn and sent
+void testTextField(void)
+{
+	std::cout << "Test 501 Text field and dirty update" << std::endl;
+	myLCD.SetFontNum(LCDFont_Default);
+	myLCD.setCursor(0, 0);
+	myLCD.print("Clock");
+	myLCD.LCDdisplayUpdate();
+
+	NOKIA_5110_TextField clock({0, 16, 84, 8}, &LCDFontTable[LCDFont_Default], LCD_AlignCenter);
+	NOKIA_5110_TextField big({0, 28, 84, 16}, &LCDFontTable[LCDFont_Mednum], LCD_AlignRight);
+	char text[16];
+	for (uint16_t seconds = 0; seconds < 100; seconds++)
+	{
+		snprintf(text, sizeof(text), "00:%02u:%02u", seconds / 60, seconds % 60);
+		clock.setText(myLCD, text);
+		snprintf(text, sizeof(text), "%u", seconds * 7);
+		big.setText(myLCD, text);
+		myLCD.LCDdisplayUpdateDirty(); // sends only the changed bytes
+		bcm2835_delay(100);
+	}
+	screenReset();
+}
+
+// Lines scroll up a bank at a time once the box is full
+void testConsole(void)
+{
+	std::cout << "Test 502 Console" << std::endl;
+	NOKIA_5110_Console console(myLCD, {0, 0, 84, 48}, &LCDFontTable[LCDFont_Default]);
+	for (uint8_t line = 0; line < 20; line++)
+	{
+		console.printfmt("Line %u ", line);
+		console.print(line * 1.5f, 1);
+		console.println();
+		myLCD.LCDdisplayUpdateDirty();
+		bcm2835_delay(250);
+	}
+	screenReset();
+}
+
+// Marquee in bank 2 , the text is rendered once and copied a window at a time
+void testTicker(void)
+{
+	std::cout << "Test 503 Ticker" << std::endl;
+	NOKIA_5110_Ticker ticker(0, 2, 84, &LCDFontTable[LCDFont_Default]);
+	ticker.setText(myLCD, "Nokia 5110 ticker, scrolled a column at a time");
+	for (uint16_t i = 0; i < 300; i++)
+	{
+		ticker.step(myLCD);
+		myLCD.LCDdisplayUpdateDirty();
+		bcm2835_delay(20);
+	}
+	screenReset();
+}
+
+// A sine wave scrolling through a chart, its level on a bar and a gauge
+void testChartBar(void)
+{
+	std::cout << "Test 504 Strip chart and bar" << std::endl;
+	NOKIA_5110_StripChart chart({0, 0, 84, 32}, -1.0f, 1.0f);
+	NOKIA_5110_Bar bar({0, 36, 60, 8}, -1.0f, 1.0f);
+	NOKIA_5110_Bar gauge({66, 32, 16, 16}, -1.0f, 1.0f, true, true, 4);
+	chart.redraw(myLCD);
+	bar.redraw(myLCD);
+	gauge.redraw(myLCD);
+	for (uint16_t i = 0; i < 200; i++)
+	{
+		float value = sinf(i * 0.1f);
+		chart.addSample(myLCD, value);
+		bar.setValue(myLCD, value);
+		gauge.setValue(myLCD, value);
+		myLCD.LCDdisplayUpdateDirty();
+		bcm2835_delay(50);
+	}
+	screenReset();
+}
+
+// 100000 samples decimated to a column each
+void testPlot(void)
+{
+	std::cout << "Test 505 Plot of a large data set" << std::endl;
+	std::vector<float> samples(100000);
+	for (size_t i = 0; i < samples.size(); i++)
+		samples[i] = sinf(i * 0.0005f) + 0.2f * sinf(i * 0.05f);
+	myLCD.drawRect(0, 0, 84, 48, LCD_BLACK);
+	myLCD.drawPlot({1, 1, 82, 46}, samples.data(), samples.size(), -1.2f, 1.2f, LCD_BLACK, 2);
+	screenReset();
+}
+
+// A popup layer shown and hidden over a background and a moving data layer
+void testCompositor(void)
+{
+	std::cout << "Test 506 Canvas and compositor" << std::endl;
+	NOKIA_5110_Canvas background(LCDWIDTH, LCDHEIGHT), data(LCDWIDTH, LCDHEIGHT);
+	NOKIA_5110_Canvas alert(LCDWIDTH, LCDHEIGHT), alertMask(LCDWIDTH, LCDHEIGHT);
+	NOKIA_5110_Compositor layers(LCDWIDTH, LCDHEIGHT);
+
+	for (uint8_t x = 0; x < LCDWIDTH; x += 6)
+		background.drawVLine(x, 0, LCDHEIGHT, LCD_BLACK);
+	alert.drawRect(12, 12, 60, 24, LCD_BLACK);
+	alert.drawText(27, 20, (char *)"ALERT", LCD_BLACK, LCD_WHITE, 1);
+	alertMask.fillRect(12, 12, 60, 24, LCD_BLACK);
+
+	layers.addLayer(background);
+	layers.addLayer(data);
+	int8_t alertLayer = layers.addLayer(alert, &alertMask, false);
+	for (uint8_t i = 0; i < 120; i++)
+	{
+		data.clear();
+		data.fillCircle(i % LCDWIDTH, 24, 6, LCD_BLACK);
+		if (i % 40 == 0)
+			layers.setVisible(alertLayer, !layers.isVisible(alertLayer));
+		if (layers.compose(myLCD))
+			myLCD.LCDdisplayUpdateDirty();
+		bcm2835_delay(50);
+	}
+	screenReset();
+}
+
+void screenReset(void) {
+	myLCD.LCDdisplayUpdate();
+	bcm2835_delay(TEST_DELAY2);
+	myLCD.LCDdisplayClear();
+}
+
+// *************** EOF ****************
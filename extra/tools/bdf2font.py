@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+"""
+@file bdf2font.py
+@brief Font compiler for the NOKIA_5110_RPI library
+@details Converts a BDF bitmap font into a C++ header holding a proportional
+	font in bank format (vertically addressed, same layout as LCDDisplayBuffer)
+	with per glyph width and offset tables, ready for SetFont().
+	Only the chosen glyphs are stored, characters left out have zero width.
+	Code points beyond ASCII are stored from character 0x80 upwards and listed
+	in a code point table, they are drawn from UTF-8 text when setTextUTF8(true).
+
+Usage:
+	python3 bdf2font.py font.bdf -n MyFont -o MyFont.hpp
+	python3 bdf2font.py font.bdf -n Digits -c "0123456789:.-" -o Digits.hpp
+	python3 bdf2font.py font.bdf -n Temp -c "0123456789.-°C" -o Temp.hpp
+
+Options:
+	-n NAME     C++ name of the LCDFont_t descriptor (default from file name)
+	-o FILE     output header (default stdout)
+	-c CHARS    characters to include, UTF-8 (default printable ASCII 0x20-0x7E)
+	-r A-B      range of code points to include, decimal or 0x hex
+	-s N        blank columns added after each glyph, multi bank fonts (default 1)
+	--fixed     keep every glyph at its advance width instead of cropping to ink
+
+In the program:
+	#include "MyFont.hpp"
+	myLCD.SetFont(&MyFont);
+
+A font up to 8 pixels high is LCDFontLayout_SingleBank (font 1-6 methods, scale-able,
+the library adds one padding column) else LCDFontLayout_MultiBank (font 7-12 methods).
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+class Glyph:
+	"""A BDF glyph, rows of pixels as integers MSB left"""
+	def __init__(self):
+		self.encoding = -1
+		self.advance = 0
+		self.bbx = (0, 0, 0, 0)
+		self.rows = []
+
+
+def parse_bdf(path):
+	"""Parse a BDF file , return (glyphs by code, ascent, descent)"""
+	glyphs = {}
+	ascent = descent = None
+	box = None
+	glyph = None
+	in_bitmap = False
+	with open(path, encoding="latin-1") as bdf:
+		for line in bdf:
+			words = line.split()
+			if not words:
+				continue
+			key = words[0]
+			if in_bitmap:
+				if key == "ENDCHAR":
+					in_bitmap = False
+					if glyph.encoding >= 0:
+						glyphs[glyph.encoding] = glyph
+					glyph = None
+				else:
+					glyph.rows.append((int(key, 16), len(key) * 4))
+				continue
+			if key == "FONTBOUNDINGBOX":
+				box = tuple(int(v) for v in words[1:5])
+			elif key == "FONT_ASCENT":
+				ascent = int(words[1])
+			elif key == "FONT_DESCENT":
+				descent = int(words[1])
+			elif key == "STARTCHAR":
+				glyph = Glyph()
+			elif key == "ENCODING" and glyph is not None:
+				glyph.encoding = int(words[1])
+			elif key == "DWIDTH" and glyph is not None:
+				glyph.advance = int(words[1])
+			elif key == "BBX" and glyph is not None:
+				glyph.bbx = tuple(int(v) for v in words[1:5])
+			elif key == "BITMAP" and glyph is not None:
+				in_bitmap = True
+	if ascent is None or descent is None:
+		if box is None:
+			sys.exit("Error: BDF has no FONT_ASCENT/FONT_DESCENT or FONTBOUNDINGBOX")
+		ascent = box[1] + box[3]
+		descent = -box[3]
+	return glyphs, ascent, descent
+
+
+def render(glyph, ascent, height):
+	"""Render a glyph into a set of (x, y) pixels in a cell 'height' high"""
+	w, h, xoff, yoff = glyph.bbx
+	pixels = set()
+	for r, (bits, nbits) in enumerate(glyph.rows[:h]):
+		y = ascent - (yoff + h) + r
+		if y < 0 or y >= height:
+			continue
+		for c in range(w):
+			if bits & (1 << (nbits - 1 - c)):
+				pixels.add((xoff + c, y))
+	return pixels
+
+
+def encode(pixels, x0, width, height):
+	"""Encode pixels into bank format , banks of 'width' column bytes LSB at top"""
+	out = []
+	for bank in range((height + 7) // 8):
+		for col in range(width):
+			byte = 0
+			for bit in range(8):
+				if (x0 + col, bank * 8 + bit) in pixels:
+					byte |= 1 << bit
+			out.append(byte)
+	return out
+
+
+def parse_code(text):
+	return int(text, 16) if text.lower().startswith("0x") else int(text)
+
+
+def main():
+	parser = argparse.ArgumentParser(description="BDF to NOKIA_5110_RPI bank format font compiler")
+	parser.add_argument("bdf")
+	parser.add_argument("-n", "--name")
+	parser.add_argument("-o", "--output")
+	parser.add_argument("-c", "--chars")
+	parser.add_argument("-r", "--range")
+	parser.add_argument("-s", "--spacing", type=int, default=1)
+	parser.add_argument("--fixed", action="store_true")
+	args = parser.parse_args()
+
+	name = args.name or re.sub(r"\W", "_", os.path.splitext(os.path.basename(args.bdf))[0])
+	glyphs, ascent, descent = parse_bdf(args.bdf)
+	height = ascent + descent
+	if height < 1 or height > 255:
+		sys.exit("Error: font height %d out of range" % height)
+	single_bank = height <= 8
+	spacing = 0 if single_bank else args.spacing
+
+	if args.chars:
+		codes = sorted(set(ord(ch) for ch in args.chars))
+	elif args.range:
+		first, last = (parse_code(v) for v in args.range.split("-"))
+		codes = list(range(first, last + 1))
+	else:
+		codes = list(range(0x20, 0x7F))
+	codes = [c for c in codes if c in glyphs and c <= 0xFFFF]
+	if not codes:
+		sys.exit("Error: none of the chosen characters are in the font")
+
+	# ASCII keeps its own character code , everything else is packed from 0x80
+	slots = {c: c for c in codes if c < 0x80}
+	wide = [c for c in codes if c >= 0x80]
+	if len(wide) > 0x80:
+		sys.exit("Error: more than 128 code points beyond ASCII, choose fewer glyphs")
+	for i, code in enumerate(wide):
+		slots[0x80 + i] = code
+
+	# the font length field is a uint8_t , a table of 256 slots does not fit ,
+	# NUL can not be printed from a string so it is the slot dropped
+	if 0x00 in slots and max(slots) == 0xFF:
+		del slots[0x00]
+		codes.remove(0x00)
+	first, last = min(slots), max(slots)
+	if last - first + 1 > 255:
+		sys.exit("Error: characters span more than 255 codes, choose fewer glyphs")
+	data, widths, offsets = [], [], []
+	for slot in range(first, last + 1):
+		offsets.append(len(data))
+		if slot not in slots:
+			widths.append(0)
+			continue
+		code = slots[slot]
+		glyph = glyphs[code]
+		pixels = render(glyph, ascent, height)
+		if pixels and not args.fixed:
+			x0 = min(x for x, _ in pixels)
+			width = max(x for x, _ in pixels) - x0 + 1 + spacing
+		else:
+			x0, width = 0, max(glyph.advance, 1)
+		if width > 255:
+			sys.exit("Error: glyph %d wider than 255 pixels" % code)
+		widths.append(width)
+		data += encode(pixels, x0, width, height)
+	if len(data) > 0xFFFF:
+		sys.exit("Error: font data larger than 64KB, choose fewer glyphs")
+
+	def table(values, fmt="0x%02X", per_line=16):
+		lines = []
+		for i in range(0, len(values), per_line):
+			lines.append("\t" + ", ".join(fmt % v for v in values[i:i + per_line]) + ",")
+		return "\n".join(lines)
+
+	layout = "LCDFontLayout_SingleBank" if single_bank else "LCDFontLayout_MultiBank"
+	header = []
+	header.append("/*!")
+	header.append("\t@file %s" % (os.path.basename(args.output) if args.output else name + ".hpp"))
+	header.append("\t@brief Proportional bank format font %s, %d pixels high, %d glyphs 0x%02X-0x%02X" % (name, height, len(codes), first, last))
+	header.append("\t@note Generated by extra/tools/bdf2font.py from %s, do not edit" % os.path.basename(args.bdf))
+	header.append("*/")
+	header.append("")
+	header.append("#pragma once")
+	header.append("")
+	header.append("#include \"NOKIA_5110_RPI_Font.hpp\"")
+	header.append("")
+	header.append("static constexpr uint8_t %s_Data[] = {\n%s\n};" % (name, table(data)))
+	header.append("")
+	header.append("static constexpr uint8_t %s_Widths[] = {\n%s\n};" % (name, table(widths)))
+	header.append("")
+	header.append("static constexpr uint16_t %s_Offsets[] = {\n%s\n};" % (name, table(offsets, "%d", 12)))
+	header.append("")
+	unicode = "nullptr, 0"
+	if wide:
+		pairs = ["{0x%04X, 0x%02X}" % (code, 0x80 + i) for i, code in enumerate(wide)]
+		header.append("static constexpr LCDFontCodePoint_t %s_Unicode[] = {\n%s\n};" % (name, table(pairs, "%s", 6)))
+		header.append("")
+		unicode = "%s_Unicode, %d" % (name, len(wide))
+	header.append("/*! %s font descriptor, pass to SetFont() */" % name)
+	header.append("static constexpr LCDFont_t %s = {%s_Data, %d, %d, 0x%02X, %d, 0, %s, %s_Widths, %s_Offsets, %s};"
+		% (name, name, max(widths), height, first, last - first + 1, layout, name, name, unicode))
+	header.append("")
+
+	text = "\n".join(header)
+	if args.output:
+		with open(args.output, "w") as out:
+			out.write(text)
+	else:
+		sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+	main()
@@ -0,0 +1,107 @@
+ /*!
+	@file  NOKIA_5110_Canvas.hpp
+	@brief header file for the off screen canvas class
+	@details Project Name: NOKIA_5110_RPI
+		URL: https://github.com/gavinlyonsrepo/NOKIA_5110_RPI
+	@author  Gavin Lyons
+*/
+
+#pragma once
+
+// Section: Includes
+#include <stdint.h>
+#include <stdbool.h>
+#include <vector>
+
+#include "NOKIA_5110_graphics.hpp"
+
+// Section: Defines
+
+#define LCD_CANVAS_MAX_HEIGHT 248 /**< Tallest canvas in pixels , a whole number of banks */
+#define LCD_MAX_LAYERS 4 /**< Most layers a compositor holds */
+
+// Section: Classes
+
+/*!
+	@brief An off screen 1-bit drawing surface of any size up to 255x248
+	@details The canvas is a bank format buffer, the same layout as LCDDisplayBuffer, so all
+		the graphics and text methods draw on it as they do on the display, including
+		rotation and dirty tracking. The buffer is owned, or supplied by the caller.
+		blit() copies all or part of it to the display, or to another canvas.
+		Canvases share no state so separate ones can be drawn from separate threads.
+*/
+class NOKIA_5110_Canvas : public NOKIA_5110_graphics
+{
+
+public:
+
+	NOKIA_5110_Canvas(uint8_t width, uint8_t height);
+	NOKIA_5110_Canvas(uint8_t *buffer, uint8_t width, uint8_t height);
+	NOKIA_5110_Canvas(const NOKIA_5110_Canvas &other);
+	NOKIA_5110_Canvas &operator=(const NOKIA_5110_Canvas &other);
+	~NOKIA_5110_Canvas(){};
+
+	virtual void LCDDrawPixel(uint8_t x, uint8_t y, bool color) override;
+	void clear();
+	void fill(uint8_t pattern = 0xFF);
+
+	LCD_Return_Codes_e blit(NOKIA_5110_graphics &dest, int16_t x, int16_t y);
+	LCD_Return_Codes_e blit(NOKIA_5110_graphics &dest, const LCD_Rect_t &sourceRect, int16_t x, int16_t y);
+	using NOKIA_5110_graphics::blit;
+
+	uint8_t *getBuffer();
+	uint16_t getBufferSize();
+	LCD_Sprite_t getSprite();
+
+private:
+
+	void setBuffer(uint8_t *buffer, uint8_t width, uint8_t height);
+
+	std::vector<uint8_t> _storage; /**< Buffer when owned by the canvas , else empty */
+};
+
+/*!
+	@brief Stacks canvases as layers and composites them into a display
+	@details Each layer is a canvas the size of the display, drawn on as normal. Layers are
+		composited bottom up, a layer is ORed onto those below it, or where it has a mask
+		canvas, out = (out AND NOT mask) OR layer , so set mask bits make the layer opaque.
+		compose() works from the layers' dirty spans, only the columns a visible layer or
+		mask changed are recomposited, 8 bytes at a time, and copied to the display, so
+		showing or hiding an alert needs no redraw of the layers under it.
+		The layer canvases' dirty tracking is used by the compositor and cleared by compose().
+*/
+class NOKIA_5110_Compositor
+{
+
+public:
+
+	NOKIA_5110_Compositor(uint8_t width, uint8_t height);
+
+	int8_t addLayer(NOKIA_5110_Canvas &canvas, NOKIA_5110_Canvas *mask = nullptr, bool visible = true);
+	void setVisible(uint8_t layer, bool visible);
+	bool isVisible(uint8_t layer);
+	void setMask(uint8_t layer, NOKIA_5110_Canvas *mask);
+	uint8_t getLayerCount();
+	bool compose(NOKIA_5110_graphics &lcd);
+
+private:
+
+	/*! One layer of the stack */
+	struct Layer_t
+	{
+		NOKIA_5110_Canvas *canvas; /**< Layer image */
+		NOKIA_5110_Canvas *mask;   /**< Opaque area of layer , nullptr if layer is ORed */
+		bool visible;              /**< Layer is composited */
+		bool changed;              /**< Visibility or mask changed since last compose */
+	};
+
+	void composeSpan(uint8_t bank, uint8_t x0, uint8_t x1);
+
+	uint8_t _width;             /**< Width of display and layers in pixels */
+	uint8_t _banks;             /**< Height of display and layers in banks */
+	uint8_t _count = 0;         /**< Number of layers */
+	Layer_t _layers[LCD_MAX_LAYERS]; /**< Layers , bottom first */
+	std::vector<uint8_t> _frame; /**< Composited image */
+};
+
+// ********************** EOF *********************
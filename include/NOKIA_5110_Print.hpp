@@ -19,12 +19,16 @@
 #endif
 #define BIN 2
 
+#define PRINT_FORMAT_BUFFER 96 // Longest text printfmt() writes, longer output is cut off
+#define PRINT_FLOAT_MAX_DECIMALS 40 // Most decimals printfmt() writes for %f, larger precision is cut to it
+
 class Print
 {
   private:
     int write_error;
-    size_t printNumber(unsigned long, uint8_t);
+    size_t printNumber(unsigned long, uint8_t, bool = false);
     size_t printFloat(double, uint8_t);
+    static char *fixedToChars(char *, char *, double, uint8_t);
   protected:
     void setWriteError(int err = 1) { write_error = err; }
   public:
@@ -67,5 +71,11 @@ class Print
     size_t println(void);
     size_t println(const std::string &s);
 
+#ifdef __GNUC__
+    size_t printfmt(const char *format, ...) __attribute__((format(printf, 2, 3)));
+#else
+    size_t printfmt(const char *format, ...);
+#endif
+
 };
 
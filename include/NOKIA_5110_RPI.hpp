@@ -62,7 +62,6 @@
 #define LCD_DIN_SetDigitalOutput bcm2835_gpio_fsel(_LCD_DIN, BCM2835_GPIO_FSEL_OUTP)
 #define LCD_CE_SetDigitalOutput bcm2835_gpio_fsel(_LCD_CE, BCM2835_GPIO_FSEL_OUTP)
 
-#define LCD_swap_uint8_t(a, b) { uint8_t t = a; a = b; b = t; }
 
 // Section : Enums
 
@@ -92,6 +91,7 @@ public:
 	virtual void LCDDrawPixel(uint8_t x, uint8_t y, bool color) override;
 	void LCDSetContrast(uint8_t con);
 	void LCDdisplayUpdate(void);
+	void LCDdisplayUpdateDirty(void);
 	void LCDdisplayClear(void);
 	void LCDfillScreen(void);
 	void LCDfillScreenPattern(uint8_t);
@@ -3,7 +3,8 @@
 	@brief  Nokia 5110  font data file 10 fonts.
 	@author Gavin Lyons.
 	@note Fonts are 1-6 are Vertically addressed single dimension array(size scale-bale)
-			Fonts 7-12 are Horizontally addressed 2 dimension array flipped 90 degrees(fixed size)
+			Fonts 7-12 are stored as columns MSB at top and re-encoded at compile time into
+			vertically addressed banks, same layout as the screen buffer(fixed size)
 	@details 
 		-#  Font_One  default  (FUll ASCII with mods)
 		-#  Font_Two  thick (NO LOWERCASE)
@@ -81,6 +82,41 @@ enum LCDFontLength_e : uint8_t
 	LCDFontLenAll = 255            /**Full Range  0-0xFF */
 };
 
+/*! How a font is laid out and drawn, selects the text methods it works with */
+enum LCDFontLayout_e : uint8_t
+{
+	LCDFontLayout_SingleBank = 0, /**< One bank high, scale-able, padding column added by SW , as fonts 1-6 */
+	LCDFontLayout_MultiBank = 1   /**< One or more banks high, fixed size , as fonts 7-12 */
+};
+
+/*! Maps a Unicode code point to the character code of its glyph in a font */
+struct LCDFontCodePoint_t
+{
+	uint16_t codePoint; /**< Unicode code point, Basic Multilingual Plane */
+	uint8_t character;  /**< Character code of the glyph in the font */
+};
+
+/*!
+	@brief Describes a font held in bank format
+	@details Fixed width: glyph for character c starts at data[(c - offset) * stride] and is 'width' wide.
+		Proportional: glyph starts at data[offsets[c - offset]] and is widths[c - offset] wide.
+		Proportional fonts are made by the font compiler extra/tools/bdf2font.py
+*/
+struct LCDFont_t
+{
+	const uint8_t *data;   /**< Glyph data, per glyph one column byte per pixel of width per 8 pixel bank */
+	uint8_t width;         /**< Width of a glyph in pixels, widest glyph for a proportional font */
+	uint8_t height;        /**< Height of a glyph in pixels */
+	uint8_t offset;        /**< ASCII code of the first glyph */
+	uint8_t length;        /**< Number of glyphs */
+	uint16_t stride;       /**< Bytes per glyph, fixed width fonts */
+	LCDFontLayout_e layout; /**< Font family, which text methods the font works with */
+	const uint8_t *widths;   /**< Proportional fonts, width of each glyph , nullptr for fixed width */
+	const uint16_t *offsets; /**< Proportional fonts, offset of each glyph in data , nullptr for fixed width */
+	const LCDFontCodePoint_t *unicode; /**< Code points beyond ASCII held in the font, sorted by code point, nullptr if none */
+	uint8_t unicodeLength;   /**< Number of entries in unicode */
+};
+
 // Font data is in the cpp file accessed thru extern pointers.
 
 extern const unsigned char * pFontDefaultptr; /**< Pointer to default font data  */
@@ -95,3 +131,6 @@ extern const uint8_t (* pFontArial16x24ptr)[48]; /**< Pointer to Arial Round fon
 extern const uint8_t (* pFontArial16x16ptr)[32]; /**< Pointer to Arial bold font data */
 extern const uint8_t (* pFontMia8x16ptr)[16]; /**< Pointer to Mia font data */
 extern const uint8_t (* pFontDedica8x12ptr)[12]; /**< Pointer to dedica font data */
+
+/*! Descriptors of the built in fonts indexed by LCDFontType_e, entry 0 is the default font */
+extern const LCDFont_t LCDFontTable[LCDFont_Dedica + 1];
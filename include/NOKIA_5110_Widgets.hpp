@@ -0,0 +1,304 @@
+ /*!
+	@file  NOKIA_5110_Widgets.hpp
+	@brief header file for the text layout and widget classes
+	@details Project Name: NOKIA_5110_RPI
+		URL: https://github.com/gavinlyonsrepo/NOKIA_5110_RPI
+	@author  Gavin Lyons
+*/
+
+#pragma once
+
+// Section: Includes
+#include <stdint.h>
+#include <stdbool.h>
+#include <vector>
+
+#include "NOKIA_5110_graphics.hpp"
+
+// Section: Defines
+
+#define LCD_LAYOUT_MAX_LINES 16 /**< Most lines a text layout holds */
+#define LCD_FIELD_MAX_CHARS 32  /**< Most characters a text field shows */
+#define LCD_CONSOLE_MAX_LINES 16 /**< Lines of history a console keeps */
+#define LCD_CONSOLE_MAX_CHARS 42 /**< Most characters in a console line */
+
+// Section: Enums
+
+/*! Horizontal alignment of text in a box */
+enum LCD_TextAlign_e : uint8_t
+{
+	LCD_AlignLeft = 0,   /**< Lines start at left of box */
+	LCD_AlignCenter = 1, /**< Lines centered in box */
+	LCD_AlignRight = 2   /**< Lines end at right of box */
+};
+
+// Section: Classes
+
+/*!
+	@brief Word wrapped, aligned and truncated text in a box , laid out once and drawn many times
+	@details layout() measures the string in the current font and stores where each line
+		starts, ends and is drawn. draw() then just draws the stored lines , no measuring.
+		The string must remain valid and unchanged while the layout is in use.
+*/
+class NOKIA_5110_TextLayout
+{
+
+public:
+
+	NOKIA_5110_TextLayout();
+
+	LCD_Return_Codes_e layout(NOKIA_5110_graphics &lcd, const char *pText, const LCD_Rect_t &box,
+		LCD_TextAlign_e align = LCD_AlignLeft, bool wrap = true, bool ellipsis = true, uint8_t size = 1);
+	LCD_Return_Codes_e draw(NOKIA_5110_graphics &lcd, uint8_t color, uint8_t bg);
+
+	uint8_t getLineCount();
+	uint16_t getWidth();
+	uint16_t getHeight();
+	bool isTruncated();
+
+private:
+
+	/*! One laid out line of text */
+	struct Line_t
+	{
+		uint16_t start;  /**< Offset of first byte in string */
+		uint16_t length; /**< Number of bytes */
+		uint16_t x;      /**< Offset of line from left of box in pixels */
+		uint16_t width;  /**< Width in pixels, including ellipsis */
+		bool ellipsis;   /**< Line ends with "..." */
+	};
+
+	void drawRun(NOKIA_5110_graphics &lcd, uint16_t &x, uint16_t y,
+		const char *pStart, const char *pEnd, uint8_t color, uint8_t bg);
+	uint16_t fitLine(NOKIA_5110_graphics &lcd, const char *pStart, const char *pEnd, uint16_t maxWidth, uint16_t &width);
+
+	const char *_pText = nullptr;    /**< Text laid out */
+	const LCDFont_t *_pFont = nullptr; /**< Font the text was laid out in */
+	LCD_Rect_t _box = {0, 0, 0, 0};  /**< Box the text was laid out in */
+	uint8_t _size = 1;               /**< Text size , fonts 1-6 */
+	uint8_t _lineHeight = 0;         /**< Height of a line in pixels */
+	uint8_t _lineCount = 0;          /**< Number of lines in _lines */
+	bool _truncated = false;         /**< Some text did not fit */
+	Line_t _lines[LCD_LAYOUT_MAX_LINES]; /**< The laid out lines */
+};
+
+/*!
+	@brief One line of text at a fixed place that redraws only the characters that change
+	@details The field remembers the glyphs it last drew. setText() redraws a character only
+		if it or its position changed, and clears only the part of the old text the new text
+		does not cover. Drawing marks just those bytes dirty, so LCDdisplayUpdateDirty() sends
+		a few bytes for a clock or counter update. Text that does not fit the box width is
+		cut off, the field is always a full line tall.
+		The background must differ from the text color so changed characters are overdrawn.
+*/
+class NOKIA_5110_TextField
+{
+
+public:
+
+	NOKIA_5110_TextField(const LCD_Rect_t &box, const LCDFont_t *pFont, LCD_TextAlign_e align = LCD_AlignLeft,
+		uint8_t color = 1, uint8_t bg = 0, uint8_t size = 1);
+
+	LCD_Return_Codes_e setText(NOKIA_5110_graphics &lcd, const char *pText);
+	void invalidate();
+
+private:
+
+	uint16_t startX(uint16_t width);
+
+	LCD_Rect_t _box;          /**< Box the field is drawn in */
+	const LCDFont_t *_pFont;  /**< Font of the field */
+	LCD_TextAlign_e _align;   /**< Horizontal alignment in box */
+	uint8_t _color;           /**< Text color */
+	uint8_t _bg;              /**< Background color */
+	uint8_t _size;            /**< Text size , fonts 1-6 */
+	bool _valid = false;      /**< Screen holds what _glyphs says , false forces a full redraw */
+	uint8_t _count = 0;       /**< Number of glyphs drawn */
+	uint16_t _textWidth = 0;  /**< Width of glyphs drawn in pixels */
+	uint8_t _glyphs[LCD_FIELD_MAX_CHARS]; /**< Character codes drawn */
+};
+
+/*!
+	@brief A scrolling text console in a box , print to it like the display
+	@details Text is kept in a ring buffer of lines, as character codes of the console font.
+		A character is drawn as it arrives. When a new line starts at the bottom of the box
+		the box is moved up a line with memmove of the bank bytes and only the new line is
+		cleared, so just those rows are marked dirty. '\n' starts a new line, '\r' is skipped,
+		lines wrap at the right of the box. Fast scrolling needs the box top and the line
+		height to be multiples of 8 and rotation 0, else the visible lines are redrawn.
+*/
+class NOKIA_5110_Console : public Print
+{
+
+public:
+
+	NOKIA_5110_Console(NOKIA_5110_graphics &lcd, const LCD_Rect_t &box, const LCDFont_t *pFont,
+		uint8_t color = 1, uint8_t bg = 0, uint8_t size = 1);
+
+	virtual size_t write(uint8_t character) override;
+	virtual size_t write(const uint8_t *buffer, size_t size) override;
+	using Print::write;
+
+	void clear();
+	void redraw();
+	void setScrollBack(uint8_t lines);
+	uint8_t getRows();
+	uint8_t getLineCount();
+
+private:
+
+	/*! One line of console text */
+	struct Line_t
+	{
+		uint8_t length;  /**< Number of characters */
+		uint8_t characters[LCD_CONSOLE_MAX_CHARS]; /**< Character codes */
+	};
+
+	void newLine();
+	void drawLine(uint8_t row, const Line_t &line);
+
+	NOKIA_5110_graphics &_lcd; /**< Display drawn on */
+	LCD_Rect_t _box;          /**< Box the console is drawn in */
+	const LCDFont_t *_pFont;  /**< Font of the console */
+	uint8_t _color;           /**< Text color */
+	uint8_t _bg;              /**< Background color */
+	uint8_t _size;            /**< Text size , fonts 1-6 */
+	uint8_t _lineHeight;      /**< Height of a line in pixels */
+	uint8_t _rows;            /**< Lines that fit in the box */
+	uint8_t _head = 0;        /**< Ring index of the line being written */
+	uint8_t _count = 1;       /**< Lines in the ring , including the one being written */
+	uint8_t _scrollBack = 0;  /**< Lines the view is scrolled back by */
+	uint16_t _x = 0;          /**< x offset of next character in the line being written */
+	bool _valid = false;      /**< Box shows the ring , false forces a redraw on next write */
+	uint32_t _codePoint = 0;  /**< UTF-8 decoder state */
+	uint8_t _pending = 0;     /**< UTF-8 decoder state */
+	Line_t _lines[LCD_CONSOLE_MAX_LINES]; /**< Ring buffer of lines */
+};
+
+/*!
+	@brief A marquee that scrolls a line of text through a bank aligned window
+	@details setText() renders the string once into an off screen bank format strip ,
+		step() moves the window along the strip and copies it into the buffer with one
+		memcpy per bank (two where the strip wraps). Fonts 1-6 are drawn at size 1.
+		A font not a multiple of 8 high writes only its own rows of the last bank.
+		Works in unrotated buffer co-ordinates.
+*/
+class NOKIA_5110_Ticker
+{
+
+public:
+
+	NOKIA_5110_Ticker(uint8_t x, uint8_t bank, uint8_t w, const LCDFont_t *pFont, uint8_t color = 1, uint8_t gap = 16);
+
+	LCD_Return_Codes_e setText(NOKIA_5110_graphics &lcd, const char *pText);
+	LCD_Return_Codes_e step(NOKIA_5110_graphics &lcd, int16_t pixels = 1);
+	LCD_Return_Codes_e draw(NOKIA_5110_graphics &lcd);
+	void setOffset(uint16_t offset);
+	uint16_t getOffset();
+	uint16_t getLength();
+
+private:
+
+	uint8_t _x;              /**< x co-ord of window in buffer */
+	uint8_t _bank;           /**< Bank of window */
+	uint8_t _w;              /**< Width of window in pixels */
+	const LCDFont_t *_pFont; /**< Font of the ticker */
+	uint8_t _color;          /**< Text color , background is the other */
+	uint8_t _gap;            /**< Blank columns after the text before it repeats */
+	uint8_t _banks = 0;      /**< Height of strip in banks */
+	uint16_t _length = 0;    /**< Width of strip in pixels */
+	uint16_t _offset = 0;    /**< Strip column at left of window */
+	std::vector<uint8_t> _strip; /**< Rendered text , _banks rows of _length bytes */
+	std::vector<uint8_t> _window; /**< Window assembled when the strip wraps */
+};
+
+/*!
+	@brief A scrolling plot of a time series , newest sample at the right of the box
+	@details Samples are kept in a ring buffer one wider than the box. addSample() scrolls the
+		box one column left with scroll() and draws just the new column, a vertical span
+		from the previous sample to the new one, or down to the bottom in fill mode.
+		With auto scale the range follows the samples held, the plot is only redrawn in
+		full when the range changes. Works in unrotated buffer co-ordinates.
+*/
+class NOKIA_5110_StripChart
+{
+
+public:
+
+	NOKIA_5110_StripChart(const LCD_Rect_t &box, float minValue, float maxValue,
+		bool autoScale = false, bool fill = false, uint8_t color = 1);
+
+	void addSample(NOKIA_5110_graphics &lcd, float value);
+	void redraw(NOKIA_5110_graphics &lcd);
+	void clear(NOKIA_5110_graphics &lcd);
+	void setRange(NOKIA_5110_graphics &lcd, float minValue, float maxValue);
+	float getMin();
+	float getMax();
+	uint16_t getSampleCount();
+
+private:
+
+	bool rescale();
+	uint8_t valueToY(float value);
+	void drawColumn(NOKIA_5110_graphics &lcd, uint8_t column, uint8_t y, uint8_t previousY);
+
+	uint8_t _x;              /**< x co-ord of box in buffer */
+	uint8_t _y;              /**< y co-ord of box in buffer */
+	uint8_t _w;              /**< Width of box */
+	uint8_t _h;              /**< Height of box */
+	float _min;              /**< Value at bottom of box */
+	float _max;              /**< Value at top of box */
+	bool _autoScale;         /**< Range follows the samples held */
+	bool _fill;              /**< Fill below the plot */
+	uint8_t _color;          /**< Plot color , background is the other */
+	uint16_t _next = 0;      /**< Ring index the next sample is stored at */
+	uint16_t _count = 0;     /**< Samples held */
+	bool _valid = false;     /**< Box shows the samples , false forces a redraw on next sample */
+	std::vector<float> _samples; /**< Ring buffer of samples */
+};
+
+/*!
+	@brief A level bar , drawn as a bar graph, a progress bar or a segmented gauge
+	@details The bar remembers how much of it is filled. setValue() fills or clears only
+		the span between the old and the new level, with byte masks, so a change of one
+		percent touches a few bytes. A border makes it a progress bar, segments make it a
+		gauge of blocks with one pixel gaps that fills a whole block at a time. Horizontal
+		bars fill from the left, vertical ones from the bottom.
+		Works in unrotated buffer co-ordinates.
+*/
+class NOKIA_5110_Bar
+{
+
+public:
+
+	NOKIA_5110_Bar(const LCD_Rect_t &box, float minValue = 0, float maxValue = 100, bool vertical = false,
+		bool border = true, uint8_t segments = 0, uint8_t color = 1);
+
+	void setValue(NOKIA_5110_graphics &lcd, float value);
+	void redraw(NOKIA_5110_graphics &lcd);
+	float getValue();
+
+private:
+
+	uint8_t valueToLength(float value);
+	void drawSpan(NOKIA_5110_graphics &lcd, uint8_t from, uint8_t to, bool on);
+
+	LCD_Rect_t _box;         /**< Box the bar is drawn in , including border */
+	uint8_t _x;              /**< x co-ord of fill area */
+	uint8_t _y;              /**< y co-ord of fill area */
+	uint8_t _w;              /**< Width of fill area */
+	uint8_t _h;              /**< Height of fill area */
+	uint8_t _length;         /**< Length of fill area along the bar */
+	uint8_t _pitch = 0;      /**< Segment width plus gap , 0 if not segmented */
+	float _min;              /**< Value of an empty bar */
+	float _max;              /**< Value of a full bar */
+	bool _vertical;          /**< Bar fills upwards */
+	bool _border;            /**< Bar has a border */
+	uint8_t _segments;       /**< Number of segments , 0 for a solid bar */
+	uint8_t _color;          /**< Bar color , background is the other */
+	float _value;            /**< Last value set */
+	uint8_t _filled = 0;     /**< Pixels filled along the bar */
+	bool _valid = false;     /**< Screen shows _filled , false forces a redraw on next value */
+};
+
+// ********************** EOF *********************
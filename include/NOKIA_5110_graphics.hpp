@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stddef.h>
 #include <iostream>
 
 #include "NOKIA_5110_Print.hpp"
@@ -21,6 +22,13 @@
 // Section defines
 #define LCD_min(a,b) (((a) < (b)) ? (a) : (b))
 #define LCD_swap_int16_t(a, b) { int16_t t = a; a = b; b = t; }
+#define LCD_swap_uint8_t(a, b) { uint8_t t = a; a = b; b = t; }
+#define LCD_MAX_SCALE_LUT 8 /**< Largest text size drawn by the scaled text lookup tables */
+#define LCD_MAX_BANKS 32 /**< Most banks (8 pixel rows) in a buffer , for dirty tracking */
+#define LCD_RETURN_CODES 16 /**< Size of the error count table , greater than the largest LCD_Return_Codes_e */
+#define LCD_PLOT_THREAD_MIN 65536 /**< Fewest samples drawPlot splits between threads */
+#define LCD_CIRCLE_TABLE_MAX 48 /**< Largest radius drawn from the circle span tables */
+#define LCD_POLYGON_MAX_POINTS 64 /**< Most vertices drawPolygon and fillPolygon take */
 
 /*! NOKIA 5110 Enum to define return codes from some text and bitmap functions  */
 enum LCD_Return_Codes_e : uint8_t
@@ -36,7 +44,8 @@ enum LCD_Return_Codes_e : uint8_t
 	LCD_BitmapVerticalSize = 10,    /**< A vertical Bitmap's height must be divisible by 8. */
 	LCD_BitmapHorizontalSize = 11,  /**< A horizontal Bitmap's width  must be divisible by 8  */
 	LCD_BitmapSize = 12,            /**< Size of the Bitmap is incorrect: BitmapSize(vertical)!=(w*(h/8),BitmapSize(horizontal)!=(w/8)*h*/
-	LCD_CustomCharLen = 13          /**< CustomChar array must always be 5 bytes long*/
+	LCD_CustomCharLen = 13,         /**< CustomChar array must always be 5 bytes long*/
+	LCD_FontInvalid = 14            /**< Font descriptor is an invalid pointer object, has zero size, a single bank font is higher than 8 or only one of widths and offsets is set*/
 };
 
 /*! Enum to hold current screen rotation in degrees  */
@@ -48,6 +57,48 @@ enum LCD_rotate_e : uint8_t
 	LCD_Degrees_270 = 3     /**< LCD screen rotated 270 degrees */
 };
 
+// Section: Types
+
+/*! Error callback , passed the error code and message of each error reported */
+typedef void (*LCD_ErrorCallback_t)(LCD_Return_Codes_e code, const char *message);
+
+// Section: Structures
+
+/*! A point , for batches of pixels */
+struct LCD_Point_t
+{
+	int16_t x; /**< x co-ord */
+	int16_t y; /**< y co-ord */
+};
+
+/*! Rectangle , used to return the overlap box of a collision */
+struct LCD_Rect_t
+{
+	int16_t x;  /**< Top left corner x co-ord */
+	int16_t y;  /**< Top left corner y co-ord */
+	uint16_t w; /**< Width in pixels */
+	uint16_t h; /**< Height in pixels */
+};
+
+/*! A sprite or mask held in bank format, the same vertically addressed
+	layout as LCDDisplayBuffer, one byte = 8 vertical pixels LSB at top,
+	banks of 'width' bytes one after another, width*((height+7)/8) bytes in total */
+struct LCD_Sprite_t
+{
+	const uint8_t *data; /**< Pointer to sprite data */
+	uint8_t width;       /**< Width of sprite in pixels */
+	uint8_t height;      /**< Height of sprite in pixels */
+};
+
+/*! A tile map of 8x8 tiles, a tile is 8 column bytes in bank format so lines up with one bank */
+struct LCD_TileMap_t
+{
+	const uint8_t *tiles; /**< Tile atlas , 8 bytes per tile, tile n at tiles[n*8] */
+	const uint8_t *map;   /**< Tile number of each map cell, row major, columns*rows bytes */
+	uint8_t columns;      /**< Width of map in tiles */
+	uint8_t rows;         /**< Height of map in tiles */
+};
+
 // Section: Classes
 
 /*! @brief Graphics class to hold graphic related functions */
@@ -62,6 +113,7 @@ public:
 	//Pixels + lines
 	// This(LCDDrawPixel) MUST be defined by the subclass:
 	virtual void LCDDrawPixel(uint8_t x, uint8_t y, bool color) = 0;
+	LCD_Return_Codes_e drawPixels(const LCD_Point_t *points, size_t count, uint8_t color);
 	void drawHLine(uint8_t x, uint8_t y, uint8_t w, bool color);
 	void drawVLine(uint8_t x, uint8_t y, uint8_t w, bool color);
 	void drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint8_t color);
@@ -73,20 +125,47 @@ public:
 	void fillCircle(uint16_t x0, uint16_t y0, uint16_t r, uint8_t color);
 	void drawTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t color);
 	void fillTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint8_t color);
+	LCD_Return_Codes_e drawPolygon(const LCD_Point_t *points, size_t count, uint8_t color);
+	LCD_Return_Codes_e fillPolygon(const LCD_Point_t *points, size_t count, uint8_t color);
 	void drawRoundRect(uint16_t x0, uint16_t y0, uint16_t w, uint16_t h, uint16_t radius, uint8_t color);
 	void fillRoundRect(uint16_t x0, uint16_t y0, uint16_t w, uint16_t h, uint16_t radius, uint8_t color);
+	void drawEllipse(uint16_t x0, uint16_t y0, uint16_t rx, uint16_t ry, uint8_t color);
+	void fillEllipse(uint16_t x0, uint16_t y0, uint16_t rx, uint16_t ry, uint8_t color);
+	void drawArc(uint16_t x0, uint16_t y0, uint8_t r, int16_t startAngle, int16_t endAngle, uint8_t color);
+	void fillArc(uint16_t x0, uint16_t y0, uint8_t r, uint8_t innerR, int16_t startAngle, int16_t endAngle, uint8_t color);
+	void drawBezier(const LCD_Point_t &p0, const LCD_Point_t &p1, const LCD_Point_t &p2, uint8_t color);
+	void drawBezier(const LCD_Point_t &p0, const LCD_Point_t &p1, const LCD_Point_t &p2,
+		const LCD_Point_t &p3, uint8_t color);
+
+	// Plots
+	LCD_Return_Codes_e drawPlot(const LCD_Rect_t &box, const float *samples, size_t count,
+		float minValue, float maxValue, uint8_t color, uint8_t threads = 1);
 
 	// Text
 	void SetFontNum(LCDFontType_e FontNumber);
+	LCD_Return_Codes_e SetFont(const LCDFont_t *pFont);
+	uint8_t getCharWidth(uint8_t character);
+	const uint8_t *getGlyph(uint8_t character, uint8_t &width);
+	uint8_t getCharAdvance(uint8_t character, uint8_t size = 1);
+	uint8_t getLineHeight(uint8_t size = 1);
+	const LCDFont_t *getFont();
+	bool nextChar(const char *&pText, uint8_t &character);
+	bool nextChar(uint8_t byte, uint32_t &codePoint, uint8_t &pending, uint8_t &character);
+	uint16_t measureText(const char *pText, uint8_t size = 1);
 	LCD_Return_Codes_e drawChar(uint16_t x, uint16_t y, uint8_t c, uint8_t color, uint8_t bg, uint8_t size);
 	LCD_Return_Codes_e drawText(uint8_t x, uint8_t y, char *pText, uint8_t color, uint8_t bg, uint8_t size);
 	LCD_Return_Codes_e drawChar(uint8_t x, uint8_t y, uint8_t c, uint8_t color , uint8_t bg);
 	LCD_Return_Codes_e drawText(uint8_t x, uint8_t y, char *pText, uint8_t color, uint8_t bg);
-	virtual size_t write(uint8_t);
+	void drawCharUnchecked(uint16_t x, uint16_t y, uint8_t character, uint8_t color, uint8_t bg, uint8_t size);
+	void drawCharUnchecked(uint8_t x, uint8_t y, uint8_t character, uint8_t color, uint8_t bg);
+	virtual size_t write(uint8_t) override;
+	virtual size_t write(const uint8_t *buffer, size_t size) override;
+	using Print::write;
 
 	void setTextColor(uint8_t c, uint8_t bg);
 	void setTextSize(uint8_t s);
 	void setTextWrap(bool w);
+	void setTextUTF8(bool utf8);
 
 	// Screen related
 	void setCursor(uint16_t x, uint16_t y);
@@ -101,6 +180,42 @@ public:
 	LCD_Return_Codes_e drawBitmap(uint16_t x, uint16_t y, const uint8_t *bitmap, uint16_t w, uint16_t h, uint8_t color, uint16_t size);
 	LCD_Return_Codes_e customChar(const uint8_t *c, uint16_t s);
 
+	// sprites + collision , bank format , unrotated buffer co-ordinates
+	LCD_Return_Codes_e drawSprite(const LCD_Sprite_t &sprite, int16_t x, int16_t y, uint8_t color);
+	static bool checkCollision(const LCD_Sprite_t &a, int16_t ax, int16_t ay,
+		const LCD_Sprite_t &b, int16_t bx, int16_t by, LCD_Rect_t *overlap = nullptr);
+	bool checkCollision(const LCD_Sprite_t &sprite, int16_t x, int16_t y, LCD_Rect_t *overlap = nullptr);
+	LCD_Return_Codes_e blit(const LCD_Sprite_t &source, const LCD_Rect_t &sourceRect, int16_t x, int16_t y);
+
+	// error reporting
+	static void printError(LCD_Return_Codes_e code, const char *message);
+	void setErrorCallback(LCD_ErrorCallback_t callback);
+	LCD_Return_Codes_e reportError(LCD_Return_Codes_e code, const char *message, uint16_t count = 1);
+	uint32_t getErrorCount(LCD_Return_Codes_e code);
+	void clearErrorCounts();
+
+	// dirty tracking , unrotated buffer co-ordinates
+	void markDirty(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
+	void markAllDirty();
+	bool scrollBanks(uint8_t x, uint8_t bank, uint8_t w, uint8_t banks, uint8_t count);
+	void clearDirty();
+	bool isDirty();
+	bool getDirtySpan(uint8_t bank, uint8_t &x0, uint8_t &x1);
+
+	// bank format data , unrotated buffer co-ordinates
+	LCD_Return_Codes_e copyBanks(const uint8_t *data, uint16_t stride, uint8_t x, uint8_t bank, uint8_t w, uint8_t banks, uint8_t lastMask = 0xFF);
+
+	// moving buffer contents , unrotated buffer co-ordinates
+	LCD_Return_Codes_e copyRect(const LCD_Rect_t &sourceRect, int16_t x, int16_t y);
+	LCD_Return_Codes_e scroll(int16_t dx, int16_t dy, bool color = false);
+	LCD_Return_Codes_e scroll(const LCD_Rect_t &rect, int16_t dx, int16_t dy, bool color = false);
+	void fillBufferRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color);
+
+	// tile map , bank format , unrotated buffer co-ordinates
+	LCD_Return_Codes_e drawTileMap(const LCD_TileMap_t &tileMap, uint16_t scrollX, uint16_t scrollY);
+	LCD_Return_Codes_e drawTileMap(const LCD_TileMap_t &tileMap, uint16_t scrollX, uint16_t scrollY,
+		uint8_t x, uint8_t bank, uint8_t w, uint8_t banks);
+
 protected:
 	LCD_rotate_e  _LCD_rotate = LCD_Degrees_0; /**< Enum to hold rotation */
 	
@@ -109,18 +224,52 @@ protected:
 	int16_t _cursorX = 0; /**< Current X co-ord cursor position */
 	int16_t _cursorY = 0; /**< Current Y co-ord cursor position */
 
-	uint8_t _FontNumber = 1; /**< Holds current font number */
+	uint8_t _FontNumber = 1; /**< Holds current font number , 0 for a user font set by SetFont */
 	uint8_t _CurrentFontWidth = 5;   /**<Holds current font width in bits */
 	uint8_t _CurrentFontoffset = 0x00;  /**<Holds current font ASCII table offset */
 	uint8_t _CurrentFontheight = 8;  /**<Holds current font height in bits */
 	uint8_t _CurrentFontLength = 255;/**<Holds current font number of characters */
+	const LCDFont_t *_pCurrentFont = &LCDFontTable[LCDFont_Default]; /**< Descriptor of current font */
 
 	uint8_t _textColor = 0xFF;   /**< Text foreground color */
 	uint8_t _textBgColor = 0x00; /**< Text background color */
 	uint8_t _textSize = 1;  /**< Size of text ,fonts 1-6 */
 	bool _textWrap = true;    /**< If set, '_textwrap' text at right edge of display*/
+	bool _textUTF8 = false;   /**< If set, text is decoded as UTF-8 and mapped to glyphs by code point */
+	uint32_t _utf8CodePoint = 0; /**< Code point being decoded by write() */
+	uint8_t _utf8Pending = 0;    /**< Continuation bytes write() still expects */
+
+	uint8_t *_buffer = nullptr; /**< Bank addressed buffer written by byte level functions, set by subclass */
+	uint8_t _bufferWidth = 0;   /**< Width of _buffer in pixels, unrotated */
+	uint8_t _bufferHeight = 0;  /**< Height of _buffer in pixels, unrotated , multiple of 8 */
+
+	LCD_ErrorCallback_t _errorCallback = printError; /**< Errors are reported to this , nullptr for none */
+	uint32_t _errorCounts[LCD_RETURN_CODES]; /**< Number of errors reported , per code */
+
+	uint8_t _dirtyMin[LCD_MAX_BANKS]; /**< Leftmost changed column of each bank , 0xFF if bank is clean */
+	uint8_t _dirtyMax[LCD_MAX_BANKS]; /**< Rightmost changed column of each bank */
+
+	/*!
+		@brief Record a changed byte of the buffer
+		@param x column
+		@param bank bank (8 pixel row)
+	*/
+	inline void markDirtyByte(uint8_t x, uint8_t bank)
+	{
+		if (x < _dirtyMin[bank]) _dirtyMin[bank] = x;
+		if (x > _dirtyMax[bank]) _dirtyMax[bank] = x;
+	}
+
+	void bankWrite(int16_t x, int16_t y, uint8_t bits, uint8_t mask, uint8_t color, uint8_t bg);
+	bool mapCodePoint(uint32_t codePoint, uint8_t &character);
 
 private:
+	void drawColumnSpan(int32_t x, int32_t y0, int32_t y1, uint8_t color);
+	void drawLineSpans(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t color);
+	void drawArcSpans(int32_t x0, int32_t y0, uint8_t r, uint8_t innerR,
+		int16_t startAngle, int16_t endAngle, uint8_t color);
+	void drawCircleSpans(int32_t left, int32_t right, int32_t top, int32_t bottom,
+		uint8_t r, uint8_t corners, bool fill, uint8_t color);
 	void drawCircleHelper(uint16_t x0, uint16_t y0, uint16_t r, uint8_t cornername, uint8_t color);
 	void fillCircleHelper(uint16_t x0, uint16_t y0, uint16_t r, uint8_t cornername, uint16_t delta, uint8_t color);
 	void drawLine_2(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, bool color);
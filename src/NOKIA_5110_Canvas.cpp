@@ -0,0 +1,343 @@
+/*!
+* @file NOKIA_5110_Canvas.cpp
+* @brief   source file for the off screen canvas class
+* @author Gavin Lyons.
+* @details <https://github.com/gavinlyonsrepo/NOKIA_5110_RPI>
+*/
+
+#include "NOKIA_5110_Canvas.hpp"
+
+/*!
+	@brief constructor for NOKIA_5110_Canvas class , the canvas owns its buffer
+	@param width Width in pixels , 1-255
+	@param height Height in pixels , rounded up to a whole bank , at most LCD_CANVAS_MAX_HEIGHT
+	@note The buffer starts clear
+*/
+NOKIA_5110_Canvas::NOKIA_5110_Canvas(uint8_t width, uint8_t height)
+{
+	if (height > LCD_CANVAS_MAX_HEIGHT) height = LCD_CANVAS_MAX_HEIGHT;
+	height = (height + 7) & ~7;
+	_storage.assign(width * (height / 8), 0x00);
+	setBuffer(_storage.data(), width, height);
+}
+
+/*!
+	@brief constructor for NOKIA_5110_Canvas class , drawing on a buffer supplied by the caller
+	@param buffer Bank format buffer of width*(height/8) bytes , must remain valid , not cleared
+	@param width Width in pixels , 1-255
+	@param height Height in pixels , a multiple of 8 , at most LCD_CANVAS_MAX_HEIGHT
+	@note A height that is not a multiple of 8 is rounded down, so no byte past the buffer is written.
+*/
+NOKIA_5110_Canvas::NOKIA_5110_Canvas(uint8_t *buffer, uint8_t width, uint8_t height)
+{
+	if (height > LCD_CANVAS_MAX_HEIGHT) height = LCD_CANVAS_MAX_HEIGHT;
+	setBuffer(buffer, width, height & ~7);
+}
+
+/*!
+	@brief copy constructor for NOKIA_5110_Canvas class
+	@param other Canvas to copy
+	@note An owned buffer is copied and the copy draws on its own buffer,
+		a buffer supplied by the caller is shared.
+*/
+NOKIA_5110_Canvas::NOKIA_5110_Canvas(const NOKIA_5110_Canvas &other)
+	: NOKIA_5110_graphics(other), _storage(other._storage)
+{
+	if (!_storage.empty())
+		_buffer = _storage.data();
+}
+
+/*!
+	@brief copy assignment for NOKIA_5110_Canvas class
+	@param other Canvas to copy
+	@return This canvas
+	@note As the copy constructor , an owned buffer is copied.
+*/
+NOKIA_5110_Canvas &NOKIA_5110_Canvas::operator=(const NOKIA_5110_Canvas &other)
+{
+	if (this == &other)
+		return *this;
+	NOKIA_5110_graphics::operator=(other);
+	_storage = other._storage;
+	if (!_storage.empty())
+		_buffer = _storage.data();
+	return *this;
+}
+
+/*!
+	@brief Set the buffer drawn on and the size of the drawing area
+	@param buffer Bank format buffer
+	@param width Width in pixels
+	@param height Height in pixels , multiple of 8
+*/
+void NOKIA_5110_Canvas::setBuffer(uint8_t *buffer, uint8_t width, uint8_t height)
+{
+	_buffer = (buffer != nullptr && width != 0 && height != 0) ? buffer : nullptr;
+	_bufferWidth = _buffer ? width : 0;
+	_bufferHeight = _buffer ? height : 0;
+	setRotation(LCD_Degrees_0);
+}
+
+/*!
+	@brief Draws a Pixel to the canvas buffer
+	@param x x coordinate
+	@param y y coordinate
+	@param color Color of pixel
+*/
+void NOKIA_5110_Canvas::LCDDrawPixel(uint8_t x, uint8_t y, bool color)
+{
+	if ((x >= _width) || (y >= _height))
+		return;
+
+	switch (_LCD_rotate) {
+	case LCD_Degrees_90:
+		LCD_swap_uint8_t(x, y);
+		y = _bufferHeight - 1 - y;
+		break;
+	case LCD_Degrees_180:
+		x = _bufferWidth - 1 - x;
+		y = _bufferHeight - 1 - y;
+		break;
+	case LCD_Degrees_270:
+		LCD_swap_uint8_t(x, y);
+		x = _bufferWidth - 1 - x;
+		break;
+	default:
+		break;
+	}
+
+	uint8_t *pByte = &_buffer[x + (uint16_t)(y / 8) * _bufferWidth];
+	uint8_t value = color ? (*pByte | (1 << (y & 7))) : (*pByte & ~(1 << (y & 7)));
+	if (value != *pByte)
+	{
+		*pByte = value;
+		markDirtyByte(x, y / 8);
+	}
+}
+
+/*!
+	@brief Clear the canvas
+*/
+void NOKIA_5110_Canvas::clear()
+{
+	fill(0x00);
+}
+
+/*!
+	@brief Fill every byte of the canvas with a pattern
+	@param pattern Bank byte , 8 vertical pixels LSB at top , 0xFF for all set
+*/
+void NOKIA_5110_Canvas::fill(uint8_t pattern)
+{
+	if (_buffer == nullptr)
+		return;
+	memset(_buffer, pattern, getBufferSize());
+	markAllDirty();
+}
+
+/*!
+	@brief Copy the whole canvas to a display or another canvas
+	@param dest Where to copy to
+	@param x x co-ord in dest of top left of canvas , may be partly off screen
+	@param y y co-ord in dest of top left of canvas , may be partly off screen
+	@return LCD_Return_Codes_e
+*/
+LCD_Return_Codes_e NOKIA_5110_Canvas::blit(NOKIA_5110_graphics &dest, int16_t x, int16_t y)
+{
+	return dest.blit(getSprite(), {0, 0, _bufferWidth, _bufferHeight}, x, y);
+}
+
+/*!
+	@brief Copy a rectangle of the canvas to a display or another canvas
+	@param dest Where to copy to
+	@param sourceRect Rectangle of the canvas to copy , unrotated canvas co-ordinates
+	@param x x co-ord in dest of top left of rectangle , may be partly off screen
+	@param y y co-ord in dest of top left of rectangle , may be partly off screen
+	@return LCD_Return_Codes_e
+	@note Bank aligned copies are a memcpy per bank, see NOKIA_5110_graphics::blit
+*/
+LCD_Return_Codes_e NOKIA_5110_Canvas::blit(NOKIA_5110_graphics &dest, const LCD_Rect_t &sourceRect, int16_t x, int16_t y)
+{
+	return dest.blit(getSprite(), sourceRect, x, y);
+}
+
+/*!
+	@brief Get the canvas buffer
+	@return pointer to bank format buffer , nullptr if the canvas has none
+*/
+uint8_t *NOKIA_5110_Canvas::getBuffer() {return _buffer;}
+
+/*!
+	@brief Get the size of the canvas buffer
+	@return size in bytes
+*/
+uint16_t NOKIA_5110_Canvas::getBufferSize() {return _bufferWidth * (_bufferHeight / 8);}
+
+/*!
+	@brief Get the canvas as a sprite , for drawSprite, checkCollision and blit
+	@return sprite of the whole canvas , valid while the canvas is
+*/
+LCD_Sprite_t NOKIA_5110_Canvas::getSprite() {return {_buffer, _bufferWidth, _bufferHeight};}
+
+// Section: NOKIA_5110_Compositor
+
+/*!
+	@brief constructor for NOKIA_5110_Compositor class
+	@param width Width of the display and layers in pixels , e.g. LCDWIDTH
+	@param height Height of the display and layers in pixels , e.g. LCDHEIGHT , multiple of 8
+*/
+NOKIA_5110_Compositor::NOKIA_5110_Compositor(uint8_t width, uint8_t height) :
+	_width(width), _banks(height / 8)
+{
+	_frame.assign(_width * _banks, 0x00);
+}
+
+/*!
+	@brief Add a layer on top of the stack
+	@param canvas Layer image , the size of the display , must remain valid
+	@param mask Opaque area of the layer , the size of the display , nullptr to OR the layer
+	@param visible Layer is composited
+	@return index of the layer , -1 if the stack is full or a canvas is the wrong size
+*/
+int8_t NOKIA_5110_Compositor::addLayer(NOKIA_5110_Canvas &canvas, NOKIA_5110_Canvas *mask, bool visible)
+{
+	if (_count >= LCD_MAX_LAYERS || canvas.getBufferSize() != _frame.size() ||
+		(mask != nullptr && mask->getBufferSize() != _frame.size()))
+		return -1;
+	_layers[_count] = {&canvas, mask, visible, true};
+	canvas.markAllDirty();
+	return _count++;
+}
+
+/*!
+	@brief Show or hide a layer , takes effect on next compose
+	@param layer index from addLayer
+	@param visible Layer is composited
+*/
+void NOKIA_5110_Compositor::setVisible(uint8_t layer, bool visible)
+{
+	if (layer >= _count || _layers[layer].visible == visible)
+		return;
+	_layers[layer].visible = visible;
+	_layers[layer].changed = true;
+	_layers[layer].canvas->markAllDirty();
+}
+
+/*!
+	@brief Check if a layer is shown
+	@param layer index from addLayer
+	@return true if visible
+*/
+bool NOKIA_5110_Compositor::isVisible(uint8_t layer)
+{
+	return (layer < _count) && _layers[layer].visible;
+}
+
+/*!
+	@brief Set or remove the mask of a layer , takes effect on next compose
+	@param layer index from addLayer
+	@param mask Opaque area of the layer , the size of the display , nullptr to OR the layer
+*/
+void NOKIA_5110_Compositor::setMask(uint8_t layer, NOKIA_5110_Canvas *mask)
+{
+	if (layer >= _count || (mask != nullptr && mask->getBufferSize() != _frame.size()))
+		return;
+	_layers[layer].mask = mask;
+	_layers[layer].changed = true;
+	_layers[layer].canvas->markAllDirty();
+}
+
+/*!
+	@brief Get the number of layers
+	@return Layer count
+*/
+uint8_t NOKIA_5110_Compositor::getLayerCount() {return _count;}
+
+/*!
+	@brief Composite the changed columns of the layers into the display buffer
+	@param lcd The display , or a canvas , the size given to the constructor
+	@return true if anything was composited , then send it with LCDdisplayUpdateDirty
+	@note Where no visible layer changed nothing is done. Changed bytes of the
+		display are marked dirty.
+*/
+bool NOKIA_5110_Compositor::compose(NOKIA_5110_graphics &lcd)
+{
+	bool composed = false;
+	for (uint8_t bank = 0; bank < _banks; bank++)
+	{
+		uint8_t x0 = 0xFF, x1 = 0;
+		for (uint8_t i = 0; i < _count; i++)
+		{
+			Layer_t &layer = _layers[i];
+			uint8_t first, last;
+			if (!layer.visible && !layer.changed)
+				continue;
+			if (layer.canvas->getDirtySpan(bank, first, last))
+			{
+				if (first < x0) x0 = first;
+				if (last > x1) x1 = last;
+			}
+			if (layer.visible && layer.mask != nullptr && layer.mask->getDirtySpan(bank, first, last))
+			{
+				if (first < x0) x0 = first;
+				if (last > x1) x1 = last;
+			}
+		}
+		if (x0 > x1)
+			continue;
+		composeSpan(bank, x0, x1);
+		lcd.copyBanks(&_frame[bank * _width + x0], _width, x0, bank, x1 - x0 + 1, 1);
+		composed = true;
+	}
+
+	for (uint8_t i = 0; i < _count; i++)
+	{
+		_layers[i].changed = false;
+		_layers[i].canvas->clearDirty();
+		if (_layers[i].mask != nullptr)
+			_layers[i].mask->clearDirty();
+	}
+	return composed;
+}
+
+/*!
+	@brief Composite a span of one bank of the visible layers into the frame
+	@param bank bank (8 pixel row)
+	@param x0 first column
+	@param x1 last column
+	@details Eight columns are combined per 64 bit word , the rest a byte at a time.
+*/
+void NOKIA_5110_Compositor::composeSpan(uint8_t bank, uint8_t x0, uint8_t x1)
+{
+	const uint16_t offset = bank * _width + x0;
+	const uint8_t w = x1 - x0 + 1;
+	uint8_t *pOut = &_frame[offset];
+	memset(pOut, 0x00, w);
+
+	for (uint8_t i = 0; i < _count; i++)
+	{
+		const Layer_t &layer = _layers[i];
+		if (!layer.visible)
+			continue;
+		const uint8_t *pLayer = layer.canvas->getBuffer() + offset;
+		const uint8_t *pMask = layer.mask ? layer.mask->getBuffer() + offset : nullptr;
+		uint8_t k = 0;
+		for (; k + 8 <= w; k += 8)
+		{
+			uint64_t out, bits, mask;
+			memcpy(&out, pOut + k, 8);
+			memcpy(&bits, pLayer + k, 8);
+			if (pMask != nullptr)
+			{
+				memcpy(&mask, pMask + k, 8);
+				out &= ~mask;
+			}
+			out |= bits;
+			memcpy(pOut + k, &out, 8);
+		}
+		for (; k < w; k++)
+			pOut[k] = (pMask ? (pOut[k] & ~pMask[k]) : pOut[k]) | pLayer[k];
+	}
+}
+
+// ********************** EOF *********************
@@ -8,6 +8,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <charconv>
 #include "NOKIA_5110_Print.hpp"
 
 // Public Methods ///////////////
@@ -49,9 +52,7 @@ size_t Print::print(long n, int base)
     return write(n);
   } else if (base == 10) {
     if (n < 0) {
-      int t = print('-');
-      n = -n;
-      return printNumber(n, 10) + t;
+      return printNumber(0UL - (unsigned long)n, 10, true);
     }
     return printNumber(n, 10);
   } else {
@@ -136,69 +137,293 @@ size_t Print::println(const std::string &s) {
     return n;
 }
 
+/*
+  printf style formatted print into a stack buffer, written as one run.
+  Supports %d %i %u %x %X %o %p %c %s %f %F %%, flags - 0 + space #, field width
+  and precision (both may be *), length modifiers hh h l ll j z t L.
+  Integers are converted with std::to_chars, floats in fixed point with up to
+  PRINT_FLOAT_MAX_DECIMALS decimals, |value| up to 1.8e19 else "ovf".
+  %e %E %g %G %a %A and %n are not supported, their argument is skipped and
+  the conversion is written as is.
+*/
+size_t Print::printfmt(const char *format, ...)
+{
+  char buf[PRINT_FORMAT_BUFFER];
+  char *out = buf;
+  char *const end = buf + sizeof(buf);
+  auto put = [&](char c) { if (out < end) *out++ = c; };
+
+  if (format == NULL) return 0;
+  va_list args;
+  va_start(args, format);
+  while (*format != '\0' && out < end) {
+    if (*format != '%') {
+      put(*format++);
+      continue;
+    }
+    const char *spec = format++;
+    if (*format == '%') {
+      put('%');
+      format++;
+      continue;
+    }
+    bool left = false, zero = false, plus = false, space = false, alternate = false;
+    for (;; format++) {
+      if (*format == '-') left = true;
+      else if (*format == '#') alternate = true;
+      else if (*format == '0') zero = true;
+      else if (*format == '+') plus = true;
+      else if (*format == ' ') space = true;
+      else break;
+    }
+    int width = 0;
+    if (*format == '*') {
+      width = va_arg(args, int);
+      if (width < 0) { left = true; width = -width; }
+      format++;
+    } else {
+      while (*format >= '0' && *format <= '9') width = width * 10 + (*format++ - '0');
+    }
+    int precision = -1;
+    if (*format == '.') {
+      format++;
+      precision = 0;
+      if (*format == '*') {
+        precision = va_arg(args, int);
+        format++;
+      } else {
+        while (*format >= '0' && *format <= '9') precision = precision * 10 + (*format++ - '0');
+      }
+    }
+    int longs = 0, shorts = 0;
+    bool sizeT = false, longDouble = false;
+    while (*format == 'h' || *format == 'l' || *format == 'j' || *format == 'z' || *format == 't' || *format == 'L') {
+      if (*format == 'l') longs++;
+      if (*format == 'h') shorts++;
+      if (*format == 'j') longs = 2;
+      if (*format == 'z' || *format == 't') sizeT = true;
+      if (*format == 'L') longDouble = true;
+      format++;
+    }
+
+    char field[64];
+    char *first = field, *last = field;
+    char sign = 0;
+    const char *prefix = "";
+    bool number = true;
+    unsigned long long value = 0;
+    int base = 10;
+    switch (*format) {
+      case 'd':
+      case 'i': {
+        long long v;
+        if (longs >= 2) v = va_arg(args, long long);
+        else if (longs == 1) v = va_arg(args, long);
+        else if (sizeT) v = va_arg(args, ptrdiff_t);
+        else v = va_arg(args, int);
+        if (longs == 0 && !sizeT && shorts >= 2) v = (signed char)v;
+        else if (longs == 0 && !sizeT && shorts == 1) v = (short)v;
+        if (v < 0) sign = '-';
+        value = (v < 0) ? 0ULL - (unsigned long long)v : (unsigned long long)v;
+        break;
+      }
+      case 'u': case 'x': case 'X': case 'o':
+        if (longs >= 2) value = va_arg(args, unsigned long long);
+        else if (longs == 1) value = va_arg(args, unsigned long);
+        else if (sizeT) value = va_arg(args, size_t);
+        else value = va_arg(args, unsigned int);
+        if (longs == 0 && !sizeT && shorts >= 2) value = (unsigned char)value;
+        else if (longs == 0 && !sizeT && shorts == 1) value = (unsigned short)value;
+        base = (*format == 'o') ? 8 : (*format == 'u') ? 10 : 16;
+        if (alternate && value != 0 && base == 16) prefix = (*format == 'X') ? "0X" : "0x";
+        break;
+      case 'p':
+        value = (uintptr_t)va_arg(args, void *);
+        base = 16;
+        prefix = "0x";
+        break;
+      case 'c':
+        *last++ = (char)va_arg(args, int);
+        number = false;
+        break;
+      case 's': {
+        const char *str = va_arg(args, const char *);
+        if (str == NULL) str = "(null)";
+        size_t len = strlen(str);
+        if (precision >= 0 && (size_t)precision < len) len = precision;
+        size_t pad = ((size_t)width > len) ? width - len : 0;
+        if (!left) while (pad) { put(' '); pad--; }
+        for (size_t i = 0; i < len; i++) put(str[i]);
+        while (pad) { put(' '); pad--; }
+        format++;
+        continue;
+      }
+      case 'f':
+      case 'F': {
+        double v = longDouble ? (double)va_arg(args, long double) : va_arg(args, double);
+        if (precision < 0) precision = 6;
+        if (precision > PRINT_FLOAT_MAX_DECIMALS) precision = PRINT_FLOAT_MAX_DECIMALS;
+        if (signbit(v) && !isnan(v)) { sign = '-'; v = -v; }
+        if (isnan(v) || isinf(v)) {
+          memcpy(field, isnan(v) ? (*format == 'F' ? "NAN" : "nan") : (*format == 'F' ? "INF" : "inf"), 3);
+          last = field + 3;
+          zero = false;
+        } else {
+          last = fixedToChars(field, field + sizeof(field), v, precision);
+          if (last == NULL) { memcpy(field, "ovf", 3); last = field + 3; zero = false; }
+        }
+        number = false;
+        break;
+      }
+      case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        // unsupported , the argument is skipped so later ones line up
+        if (longDouble) (void)va_arg(args, long double);
+        else (void)va_arg(args, double);
+        while (spec <= format && *spec != '\0') put(*spec++);
+        format++;
+        continue;
+      case 'n':
+        (void)va_arg(args, void *);
+        format++;
+        continue;
+      default:
+        // unknown conversion , written as is
+        while (spec <= format && *spec != '\0') put(*spec++);
+        if (*format != '\0') format++;
+        continue;
+    }
+    if (number) {
+      // integer digits, at least 'precision' of them
+      last = std::to_chars(field, field + sizeof(field), value, base).ptr;
+      if (*format == 'X')
+        for (char *p = field; p < last; p++) if (*p >= 'a') *p -= 'a' - 'A';
+      if (precision >= 0) {
+        zero = false;
+        if (precision == 0 && value == 0) last = field;
+        int digits = last - field;
+        if (precision > digits && precision < (int)sizeof(field)) {
+          memmove(field + precision - digits, field, digits);
+          memset(field, '0', precision - digits);
+          last = field + precision;
+        }
+      }
+      if (alternate && base == 8 && field[0] != '0' && last < field + sizeof(field)) {
+        memmove(field + 1, field, last - field);
+        field[0] = '0';
+        last++;
+      }
+    }
+    if (sign == 0 && plus && (*format == 'd' || *format == 'i' || *format == 'f' || *format == 'F')) sign = '+';
+    if (sign == 0 && space && (*format == 'd' || *format == 'i' || *format == 'f' || *format == 'F')) sign = ' ';
+
+    int len = (last - first) + (sign ? 1 : 0) + strlen(prefix);
+    int pad = (width > len) ? width - len : 0;
+    if (!left && !zero) while (pad) { put(' '); pad--; }
+    if (sign) put(sign);
+    while (*prefix != '\0') put(*prefix++);
+    if (!left && zero) while (pad) { put('0'); pad--; }
+    while (first < last) put(*first++);
+    while (pad) { put(' '); pad--; }
+    format++;
+  }
+  va_end(args);
+  return write((const uint8_t *)buf, out - buf);
+}
+
 // Private Methods ////////
 
-size_t Print::printNumber(unsigned long n, uint8_t base)
+size_t Print::printNumber(unsigned long n, uint8_t base, bool negative)
 {
-  char buf[8 * sizeof(long) + 1]; // Assumes 8-bit chars plus zero byte.
-  char *str = &buf[sizeof(buf) - 1];
-
-  *str = '\0';
+  char buf[8 * sizeof(long) + 2]; // Assumes 8-bit chars plus sign.
+  char *str = buf;
 
   // prevent crash if called with base == 1
-  if (base < 2) base = 10;
+  if (base < 2 || base > 36) base = 10;
 
-  do {
-    char c = n % base;
-    n /= base;
+  if (negative) *str++ = '-';
+  char *last = std::to_chars(str, buf + sizeof(buf), n, base).ptr;
+  for (; str < last; str++)
+    if (*str >= 'a') *str -= 'a' - 'A';
 
-    *--str = c < 10 ? c + '0' : c + 'A' - 10;
-  } while(n);
+  return write(buf, last - buf);
+}
 
-  return write(str);
+/*
+  Convert a non negative number to fixed point text with 'digits' decimals,
+  rounded, without a terminating zero. Returns the end of the text, or NULL
+  if the number is too large (>= 1.8e19) or the text does not fit.
+  Up to 9 decimals are rounded once in fixed point, more are taken from
+  the remainder one at a time.
+*/
+char *Print::fixedToChars(char *first, char *last, double number, uint8_t digits)
+{
+  static const uint32_t pow10[10] = {1, 10, 100, 1000, 10000, 100000, 1000000,
+    10000000, 100000000, 1000000000};
+
+  unsigned long long intPart;
+  uint32_t fracPart = 0;
+  double remainder = 0.0;
+  if (digits > 9) {
+    double rounding = 0.5;
+    for (uint8_t i = 0; i < digits; ++i)
+      rounding /= 10.0;
+    number += rounding;
+    if (!(number < 18446744073709551615.0)) return NULL;
+    intPart = (unsigned long long)number;
+    remainder = number - (double)intPart;
+  } else {
+    double scaled = number * pow10[digits] + 0.5;
+    if (scaled < 18446744073709551615.0) {
+      // round once in fixed point, then split
+      unsigned long long fixed = (unsigned long long)scaled;
+      intPart = fixed / pow10[digits];
+      fracPart = fixed % pow10[digits];
+    } else {
+      number += 0.5 / pow10[digits];
+      if (!(number < 18446744073709551615.0)) return NULL;
+      intPart = (unsigned long long)number;
+      fracPart = (uint32_t)((number - (double)intPart) * pow10[digits]);
+      if (fracPart >= pow10[digits]) fracPart = pow10[digits] - 1;
+    }
+  }
+
+  std::to_chars_result result = std::to_chars(first, last, intPart);
+  if (result.ec != std::errc() || last - result.ptr < digits + 1) return NULL;
+  char *str = result.ptr;
+  if (digits == 0) return str;
+  *str++ = '.';
+  if (digits > 9) {
+    // extract digits from the remainder one at a time
+    for (uint8_t i = 0; i < digits; i++) {
+      remainder *= 10.0;
+      unsigned int toPrint = (unsigned int)remainder;
+      *str++ = '0' + toPrint;
+      remainder -= toPrint;
+    }
+    return str;
+  }
+  for (uint8_t i = digits; i > 0; i--) {
+    str[i - 1] = '0' + fracPart % 10;
+    fracPart /= 10;
+  }
+  return str + digits;
 }
 
 size_t Print::printFloat(double number, uint8_t digits) 
 { 
-  size_t n = 0;
-  
   if (isnan(number)) return print("nan");
   if (isinf(number)) return print("inf");
   if (number > 4294967040.0) return print ("ovf");  // constant determined empirically
   if (number <-4294967040.0) return print ("ovf");  // constant determined empirically
-  
-  // Handle negative numbers
+
+  // Format into one buffer and write it as one run
+  char buf[24 + 256];
+  char *str = buf;
   if (number < 0.0)
   {
-     n += print('-');
+     *str++ = '-';
      number = -number;
   }
-
-  // Round correctly so that print(1.999, 2) prints as "2.00"
-  double rounding = 0.5;
-  for (uint8_t i=0; i<digits; ++i)
-    rounding /= 10.0;
-  
-  number += rounding;
-
-  // Extract the integer part of the number and print it
-  unsigned long int_part = (unsigned long)number;
-  double remainder = number - (double)int_part;
-  n += print(int_part);
-
-  // Print the decimal point, but only if there are digits beyond
-  if (digits > 0) {
-    n += print('.'); 
-  }
-
-  // Extract digits from the remainder one at a time
-  while (digits-- > 0)
-  {
-    remainder *= 10.0;
-    unsigned int toPrint = (unsigned int)(remainder);
-    n += print(toPrint);
-    remainder -= toPrint; 
-  } 
-  
-  return n;
+  str = fixedToChars(str, buf + sizeof(buf), number, digits);
+  return write(buf, str - buf);
 }
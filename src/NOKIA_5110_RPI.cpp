@@ -25,6 +25,9 @@ NOKIA_5110_RPI::NOKIA_5110_RPI(uint8_t LCD_RST, uint8_t LCD_DC, uint8_t LCD_CE,
 	_LCD_DIN  = LCD_DIN;
 	_LCD_CLK  = LCD_CLK;
 	_LCDHardwareSPI = false;
+	_buffer = LCDDisplayBuffer;
+	_bufferWidth = LCDWIDTH;
+	_bufferHeight = LCDHEIGHT;
 }
 
 
@@ -43,6 +46,9 @@ NOKIA_5110_RPI::NOKIA_5110_RPI(uint8_t LCD_RST, uint8_t LCD_DC, uint32_t spi_div
 	_LCD_SPICLK_DIVIDER  = spi_divider; // HW SPI only
 	_LCD_SPICE_PIN = SPICE_Pin; // HW SPI only
 	_LCDHardwareSPI = true;
+	_buffer = LCDDisplayBuffer;
+	_bufferWidth = LCDWIDTH;
+	_bufferHeight = LCDHEIGHT;
 }
 
 
@@ -216,6 +222,30 @@ void NOKIA_5110_RPI::LCDdisplayUpdate(void) {
 	LCDWriteData( LCDDisplayBuffer[i] );
 
 	if (isHardwareSPI() == false)LCD_CE_SetHigh;
+	clearDirty();
+}
+
+/*!
+	@brief Writes only the changed parts of the buffer to the LCD
+	@details For each bank the span of columns changed since the last update is sent,
+		after setting the LCD address to its start. Changes are tracked by the drawing
+		methods, see markDirty.
+*/
+void NOKIA_5110_RPI::LCDdisplayUpdateDirty(void) {
+	for (uint8_t bank = 0; bank < LCDHEIGHT / 8; bank++)
+	{
+		if (_dirtyMin[bank] > _dirtyMax[bank])
+			continue;
+		LCDWriteCommand(LCD_SETYADDR | bank);
+		LCDWriteCommand(LCD_SETXADDR | _dirtyMin[bank]);
+
+		LCD_DC_SetHigh; //Data send
+		if (isHardwareSPI() == false)LCD_CE_SetLow;
+		for (uint8_t x = _dirtyMin[bank]; x <= _dirtyMax[bank]; x++)
+			LCDWriteData( LCDDisplayBuffer[x + bank * LCDWIDTH] );
+		if (isHardwareSPI() == false)LCD_CE_SetHigh;
+	}
+	clearDirty();
 }
 
 
@@ -248,10 +278,13 @@ void NOKIA_5110_RPI::LCDDrawPixel(uint8_t x, uint8_t y, bool color) {
 	if ( (x >= LCDWIDTH) || (y >= LCDHEIGHT) )
 	return;
 
-	if (color)
-		LCDDisplayBuffer[x + (uint16_t)(y / 8) * LCDWIDTH] |=  (1 << (y & 7));
-	else
-		LCDDisplayBuffer[x + (uint16_t)(y / 8) * LCDWIDTH] &=  ~(1 << (y & 7));
+	uint8_t *pByte = &LCDDisplayBuffer[x + (uint16_t)(y / 8) * LCDWIDTH];
+	uint8_t value = color ? (*pByte | (1 << (y & 7))) : (*pByte & ~(1 << (y & 7)));
+	if (value != *pByte)
+	{
+		*pByte = value;
+		markDirtyByte(x, y / 8);
+	}
 }
 
 
@@ -262,6 +295,7 @@ void NOKIA_5110_RPI::LCDdisplayClear(void) {
 	uint16_t i;
 	for (i = 0; i < ((LCDWIDTH*LCDHEIGHT) / 8) ; i++)  // 504 = LCDWIDTH*LCDHEIGHT / 8
 		LCDDisplayBuffer[i] = 0x00;
+	markAllDirty();
 }
 
 /*!
@@ -271,6 +305,7 @@ void NOKIA_5110_RPI::LCDfillScreen() {
 	uint16_t i;
 	for (i = 0; i < ((LCDWIDTH*LCDHEIGHT) / 8); i++)  // 504 = LCDWIDTH*LCDHEIGHT / 8
 		LCDDisplayBuffer[i] = 0xFF;
+	markAllDirty();
 }
 
 /*!
@@ -281,6 +316,7 @@ void NOKIA_5110_RPI::LCDfillScreenPattern(uint8_t Pattern) {
 	uint16_t i;
 	for (i = 0; i < ((LCDWIDTH*LCDHEIGHT) / 8); i++)  // 504 = LCDWIDTH*LCDHEIGHT / 8
 		LCDDisplayBuffer[i] = Pattern;
+	markAllDirty();
 }
 
 
@@ -5,8 +5,49 @@
 * @details <https://github.com/gavinlyonsrepo/NOKIA_5110_RPI>
 */
 
+#include <stddef.h>
 #include "NOKIA_5110_RPI_Font.hpp"
 
+/*!
+	@brief Glyph table of a font re-encoded into bank format
+	@tparam Glyphs number of glyphs
+	@tparam Bytes bytes per glyph
+*/
+template <size_t Glyphs, size_t Bytes>
+struct LCDBankFont_t
+{
+	uint8_t glyph[Glyphs][Bytes]; /**< glyph data, bank 0 columns then bank 1 columns etc */
+};
+
+/*!
+	@brief Re-encode a font 7-12 table into bank format at compile time.
+	@tparam Width width of font in pixels
+	@tparam Height height of font in pixels
+	@param columns Source table , each column is Height bits MSB at top packed into (Height+7)/8 bytes
+	@return The same glyphs as Width byte columns per bank, LSB at top , as LCDDisplayBuffer
+*/
+template <uint8_t Width, uint8_t Height, size_t Glyphs, size_t Bytes>
+static constexpr LCDBankFont_t<Glyphs, Bytes> transcodeFont(const uint8_t (&columns)[Glyphs][Bytes])
+{
+	constexpr uint8_t banks = (Height + 7) / 8;
+	static_assert(Bytes == Width * banks, "Font table size does not match width and height");
+
+	LCDBankFont_t<Glyphs, Bytes> out{};
+	for (size_t g = 0; g < Glyphs; g++)
+		for (uint8_t col = 0; col < Width; col++)
+			for (uint8_t bank = 0; bank < banks; bank++)
+			{
+				uint8_t in = columns[g][col * banks + bank];
+				uint8_t bits = 0;
+				for (uint8_t bit = 0; bit < 8; bit++)
+					if (in & (0x80 >> bit)) bits |= (1 << bit);
+				if ((bank + 1) * 8 > Height)
+					bits &= 0xFF >> ((bank + 1) * 8 - Height);
+				out.glyph[g][bank * Width + col] = bits;
+			}
+	return out;
+}
+
 /*! Standard ASCII 5x7 font , default. */
 static const unsigned char LCD_Font_One[]  = {
 	0x00, 0x00, 0x00, 0x00, 0x00,   
@@ -708,7 +749,7 @@ static const unsigned char LCD_Font_Six[] = {
  NUMBERS + ": . / - " ONLY  
  14 characters, ( 16 X 32/8 = 64 )
  */
-static const uint8_t LCD_Font_Seven [14][64] = 
+static constexpr uint8_t LCD_Font_Seven[14][64] = 
 {
 	{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x3e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, //"-"
 	{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3f,0x80,0x00,0x00,0x7f,0xc0,0x00,0x00,0xff,0xe0,0x00,0x00,0xff,0xe0,0x00,0x00,0xff,0xe0,0x00,0x00,0xff,0xe0,0x00,0x00,0xff,0xe0,0x00,0x00,0x7f,0xc0,0x00,0x00,0x3f,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // "."
@@ -732,7 +773,7 @@ static const uint8_t LCD_Font_Seven [14][64] =
  NUMBERS + ": . / - " ONLY  
  14 characters, ( 16 X 16/8 = 32)
  */
-static const  uint8_t LCD_Font_Eight[14][32] = 
+static constexpr uint8_t LCD_Font_Eight[14][32] = 
 {
 	{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x80,0x01,0x80,0x01,0x80,0x01,0x80,0x01,0x80,0x01,0x80,0x01,0x80,0x01,0x80,0x01,0x80,0x01,0x80,0x00,0x00,0x00,0x00}, //"-"
 	{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0x00,0x30,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
@@ -754,7 +795,7 @@ static const  uint8_t LCD_Font_Eight[14][32] =
  Arial_round_16x24
  oct 2023, Klaus Knösel Source : http://www.rinkydinkelectronics.com/r_fonts.php
  */
-static const uint8_t LCD_Font_Nine [96][48] = 
+static constexpr uint8_t LCD_Font_Nine[96][48] = 
 {
 {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
 {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7F,0xC0,0x00,0x7F,0xFE,0x1E,0x7F,0xFE,0x1E,0x7F,0xFE,0x1E,0x7F,0xC0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // "!"
@@ -857,7 +898,7 @@ static const uint8_t LCD_Font_Nine [96][48] =
 	Arial_bold_16x16
 	oct 2023, Klaus Knösel Source : http://www.rinkydinkelectronics.com/r_fonts.php
 */
-static const uint8_t LCD_Font_Ten [96][32] =
+static constexpr uint8_t LCD_Font_Ten[96][32] =
 {
 {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, //" "
 {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x7F,0xD8,0x7F,0xD8,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00}, // "!"
@@ -956,7 +997,7 @@ static const uint8_t LCD_Font_Ten [96][32] =
 {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x30,0x00,0x60,0x00,0x60,0x00,0x60,0x00,0x70,0x00,0x30,0x00,0x30,0x00,0x30,0x00,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00},
 }; 
 
-static const uint8_t LCD_Font_Eleven[95][16] = {
+static constexpr uint8_t LCD_Font_Eleven[95][16] = {
 	{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*" ",0*/
 	{0x00,0x00,0x00,0x00,0x00,0x00,0x1F,0xCC,0x00,0x0C,0x00,0x00,0x00,0x00,0x00,0x00},/*"!",1*/
 	{0x00,0x00,0x08,0x00,0x30,0x00,0x60,0x00,0x08,0x00,0x30,0x00,0x60,0x00,0x00,0x00},/*""",2*/
@@ -1055,7 +1096,7 @@ static const uint8_t LCD_Font_Eleven[95][16] = {
 };
 
 /*! Font 6x12 95 characters Dedica */
-static const uint8_t LCD_Font_Twelve[95][12] = {
+static constexpr uint8_t LCD_Font_Twelve[95][12] = {
 	{0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00},/*" ",0*/
 	{0x00,0x00,0x00,0x00,0x3F,0x40,0x00,0x00,0x00,0x00,0x00,0x00},/*"!",1*/
 	{0x00,0x00,0x30,0x00,0x40,0x00,0x30,0x00,0x40,0x00,0x00,0x00},/*""",2*/
@@ -1159,9 +1200,73 @@ const unsigned char * pFontSevenSegptr = LCD_Font_Three;
 const unsigned char * pFontWideptr = LCD_Font_Four;
 const unsigned char * pFontTinyptr = LCD_Font_Five;
 const unsigned char * pFontHomeSpunptr = LCD_Font_Six;
-const uint8_t (* pFontBigNumptr)[64] = LCD_Font_Seven;
-const uint8_t (* pFontMedNumptr)[32] = LCD_Font_Eight;
-const uint8_t (* pFontArial16x24ptr)[48] = LCD_Font_Nine;
-const uint8_t (* pFontArial16x16ptr)[32] = LCD_Font_Ten;
-const uint8_t (* pFontMia8x16ptr)[16] = LCD_Font_Eleven;
-const uint8_t (* pFontDedica8x12ptr)[12] = LCD_Font_Twelve;
+
+/*! Unicode code points held in the default font , its upper half is code page 437
+	with the glyph for 0xB2 left out so glyphs 0xB3 onwards sit one place lower */
+static constexpr LCDFontCodePoint_t LCD_Font_One_Unicode[] =
+{
+	{0x00A0, 0xFE}, {0x00A1, 0xAD}, {0x00A2, 0x9B}, {0x00A3, 0x9C}, {0x00A5, 0x9D}, {0x00AA, 0xA6},
+	{0x00AB, 0xAE}, {0x00AC, 0xAA}, {0x00B0, 0xF7}, {0x00B1, 0xF0}, {0x00B2, 0xFC}, {0x00B5, 0xE5},
+	{0x00B7, 0xF9}, {0x00BA, 0xA7}, {0x00BB, 0xAF}, {0x00BC, 0xAC}, {0x00BD, 0xAB}, {0x00BF, 0xA8},
+	{0x00C4, 0x8E}, {0x00C5, 0x8F}, {0x00C6, 0x92}, {0x00C7, 0x80}, {0x00C9, 0x90}, {0x00D1, 0xA5},
+	{0x00D6, 0x99}, {0x00DC, 0x9A}, {0x00DF, 0xE0}, {0x00E0, 0x85}, {0x00E1, 0xA0}, {0x00E2, 0x83},
+	{0x00E4, 0x84}, {0x00E5, 0x86}, {0x00E6, 0x91}, {0x00E7, 0x87}, {0x00E8, 0x8A}, {0x00E9, 0x82},
+	{0x00EA, 0x88}, {0x00EB, 0x89}, {0x00EC, 0x8D}, {0x00ED, 0xA1}, {0x00EE, 0x8C}, {0x00EF, 0x8B},
+	{0x00F1, 0xA4}, {0x00F2, 0x95}, {0x00F3, 0xA2}, {0x00F4, 0x93}, {0x00F6, 0x94}, {0x00F7, 0xF5},
+	{0x00F9, 0x97}, {0x00FA, 0xA3}, {0x00FB, 0x96}, {0x00FC, 0x81}, {0x00FF, 0x98}, {0x0192, 0x9F},
+	{0x0393, 0xE1}, {0x0398, 0xE8}, {0x03A3, 0xE3}, {0x03A6, 0xE7}, {0x03A9, 0xE9}, {0x03B1, 0xDF},
+	{0x03B4, 0xEA}, {0x03B5, 0xED}, {0x03BC, 0xE5}, {0x03C0, 0xE2}, {0x03C3, 0xE4}, {0x03C4, 0xE6},
+	{0x03C6, 0xEC}, {0x2022, 0xF8}, {0x207F, 0xFB}, {0x20A7, 0x9E}, {0x2219, 0xF8}, {0x221A, 0xFA},
+	{0x221E, 0xEB}, {0x2229, 0xEE}, {0x2248, 0xF6}, {0x2261, 0xEF}, {0x2264, 0xF2}, {0x2265, 0xF1},
+	{0x2310, 0xA9}, {0x2320, 0xF3}, {0x2321, 0xF4}, {0x2500, 0xC3}, {0x2502, 0xB2}, {0x250C, 0xD9},
+	{0x2510, 0xBE}, {0x2514, 0xBF}, {0x2518, 0xD8}, {0x253C, 0xC4}, {0x2580, 0xDE}, {0x2584, 0xDB},
+	{0x2588, 0xDA}, {0x258C, 0xDC}, {0x2590, 0xDD}, {0x2591, 0xB0}, {0x2592, 0xB1}, {0x25A0, 0xFD},
+};
+
+/*!
+	@brief Check a code point table is sorted, it is binary searched
+	@param table The table
+	@return true if sorted and unique
+*/
+template <size_t N>
+static constexpr bool isSortedUnicode(const LCDFontCodePoint_t (&table)[N])
+{
+	for (size_t i = 1; i < N; i++)
+		if (table[i - 1].codePoint >= table[i].codePoint) return false;
+	return true;
+}
+static_assert(isSortedUnicode(LCD_Font_One_Unicode), "Default font code point table must be sorted");
+
+// Fonts 7-12 re-encoded into bank format at compile time
+static constexpr auto LCD_Font_Seven_Bank = transcodeFont<16, 32>(LCD_Font_Seven);
+static constexpr auto LCD_Font_Eight_Bank = transcodeFont<16, 16>(LCD_Font_Eight);
+static constexpr auto LCD_Font_Nine_Bank = transcodeFont<16, 24>(LCD_Font_Nine);
+static constexpr auto LCD_Font_Ten_Bank = transcodeFont<16, 16>(LCD_Font_Ten);
+static constexpr auto LCD_Font_Eleven_Bank = transcodeFont<8, 16>(LCD_Font_Eleven);
+static constexpr auto LCD_Font_Twelve_Bank = transcodeFont<6, 12>(LCD_Font_Twelve);
+
+const uint8_t (* pFontBigNumptr)[64] = LCD_Font_Seven_Bank.glyph;
+const uint8_t (* pFontMedNumptr)[32] = LCD_Font_Eight_Bank.glyph;
+const uint8_t (* pFontArial16x24ptr)[48] = LCD_Font_Nine_Bank.glyph;
+const uint8_t (* pFontArial16x16ptr)[32] = LCD_Font_Ten_Bank.glyph;
+const uint8_t (* pFontMia8x16ptr)[16] = LCD_Font_Eleven_Bank.glyph;
+const uint8_t (* pFontDedica8x12ptr)[12] = LCD_Font_Twelve_Bank.glyph;
+
+extern constexpr LCDFont_t LCDFontTable[LCDFont_Dedica + 1] =
+{
+	{LCD_Font_One, LCDFontWidth_5, LCDFontHeight_8, LCDFontOffset_Extend, LCDFontLenAll, LCDFontWidth_5, LCDFontLayout_SingleBank, nullptr, nullptr,
+		LCD_Font_One_Unicode, sizeof(LCD_Font_One_Unicode) / sizeof(LCD_Font_One_Unicode[0])},
+	{LCD_Font_One, LCDFontWidth_5, LCDFontHeight_8, LCDFontOffset_Extend, LCDFontLenAll, LCDFontWidth_5, LCDFontLayout_SingleBank, nullptr, nullptr,
+		LCD_Font_One_Unicode, sizeof(LCD_Font_One_Unicode) / sizeof(LCD_Font_One_Unicode[0])},
+	{LCD_Font_Two, LCDFontWidth_7, LCDFontHeight_8, LCDFontOffset_Space, LCDFontLenAlphaNumNoLCase, LCDFontWidth_7, LCDFontLayout_SingleBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Three, LCDFontWidth_4, LCDFontHeight_8, LCDFontOffset_Space, LCDFontLenAlphaNum, LCDFontWidth_4, LCDFontLayout_SingleBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Four, LCDFontWidth_8, LCDFontHeight_8, LCDFontOffset_Space, LCDFontLenAlphaNumNoLCase, LCDFontWidth_8, LCDFontLayout_SingleBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Five, LCDFontWidth_3, LCDFontHeight_8, LCDFontOffset_Space, LCDFontLenAlphaNum, LCDFontWidth_3, LCDFontLayout_SingleBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Six, LCDFontWidth_7, LCDFontHeight_8, LCDFontOffset_Space, LCDFontLenAlphaNum, LCDFontWidth_7, LCDFontLayout_SingleBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Seven_Bank.glyph[0], LCDFontWidth_16, LCDFontHeight_32, LCDFontOffset_Minus, LCDFontLenNumeric, 64, LCDFontLayout_MultiBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Eight_Bank.glyph[0], LCDFontWidth_16, LCDFontHeight_16, LCDFontOffset_Minus, LCDFontLenNumeric, 32, LCDFontLayout_MultiBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Nine_Bank.glyph[0], LCDFontWidth_16, LCDFontHeight_24, LCDFontOffset_Space, LCDFontLenAlphaNum, 48, LCDFontLayout_MultiBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Ten_Bank.glyph[0], LCDFontWidth_16, LCDFontHeight_16, LCDFontOffset_Space, LCDFontLenAlphaNum, 32, LCDFontLayout_MultiBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Eleven_Bank.glyph[0], LCDFontWidth_8, LCDFontHeight_16, LCDFontOffset_Space, LCDFontLenAlphaNum, 16, LCDFontLayout_MultiBank, nullptr, nullptr, nullptr, 0},
+	{LCD_Font_Twelve_Bank.glyph[0], LCDFontWidth_6, LCDFontHeight_12, LCDFontOffset_Space, LCDFontLenAlphaNum, 12, LCDFontLayout_MultiBank, nullptr, nullptr, nullptr, 0}
+};
@@ -0,0 +1,977 @@
+/*!
+* @file NOKIA_5110_Widgets.cpp
+* @brief   source file for the text layout and widget classes
+* @author Gavin Lyons.
+* @details <https://github.com/gavinlyonsrepo/NOKIA_5110_RPI>
+*/
+
+#include "NOKIA_5110_Widgets.hpp"
+
+/*!
+	@brief Draw a character with the unchecked drawChar method for the current font's family
+	@param lcd The display
+	@param x x-co-ord
+	@param y y-co-ord
+	@param character The character , in the current font
+	@param color foreground color
+	@param bg background color
+	@param size Text size , fonts 1-6 only
+	@note The widgets measure their text first, which skips characters not in the font ,
+		and pixels off screen are clipped, so the drawChar checks are not needed.
+*/
+static void drawGlyph(NOKIA_5110_graphics &lcd, uint16_t x, uint16_t y, uint8_t character,
+	uint8_t color, uint8_t bg, uint8_t size)
+{
+	if (lcd.getFont()->layout == LCDFontLayout_SingleBank)
+		lcd.drawCharUnchecked(x, y, character, color, bg, size);
+	else
+		lcd.drawCharUnchecked((uint8_t)x, (uint8_t)y, character, color, bg);
+}
+
+// Section: NOKIA_5110_TextLayout
+
+/*!
+	@brief constructor for NOKIA_5110_TextLayout class
+*/
+NOKIA_5110_TextLayout::NOKIA_5110_TextLayout()
+{
+}
+
+/*!
+	@brief Lay out a string in a box in the current font
+	@param lcd The display, its current font and text encoding are used
+	@param pText pointer to character array , must remain valid while the layout is used
+	@param box Box to lay the text out in
+	@param align Horizontal alignment of each line
+	@param wrap true to wrap at spaces (or mid word if a word does not fit) , false for one line per '\n'
+	@param ellipsis true to end a line that is cut short with "..."
+	@param size Text size , fonts 1-6 only
+	@return LCD_Return_Codes_e
+	@note '\n' starts a new line. Lines that do not fit in the box height are dropped.
+*/
+LCD_Return_Codes_e NOKIA_5110_TextLayout::layout(NOKIA_5110_graphics &lcd, const char *pText, const LCD_Rect_t &box,
+	LCD_TextAlign_e align, bool wrap, bool ellipsis, uint8_t size)
+{
+	_lineCount = 0;
+	_truncated = false;
+	_pText = nullptr;
+	if (pText == nullptr)
+	{
+		return lcd.reportError(LCD_CharArrayNullptr, "Error TextLayout layout 1: String array is not valid pointer");
+	}
+	if (size == 0) size = 1;
+	_pText = pText;
+	_pFont = lcd.getFont();
+	_box = box;
+	_size = size;
+	_lineHeight = lcd.getLineHeight(size);
+
+	uint16_t maxLines = box.h / _lineHeight;
+	if (maxLines > LCD_LAYOUT_MAX_LINES) maxLines = LCD_LAYOUT_MAX_LINES;
+
+	const char *p = pText;
+	while (*p != '\0')
+	{
+		if (_lineCount == maxLines)
+		{
+			_truncated = true;
+			break;
+		}
+		const char *pStart = p;
+		const char *pEnd = nullptr;   // end of this line
+		const char *pBreak = nullptr; // last space , where a wrap can go
+		const char *pResume = nullptr;// start of next line if wrapped at pBreak
+		uint16_t width = 0, breakWidth = 0;
+		bool cut = false;
+		for (;;)
+		{
+			if (*p == '\0' || *p == '\n')
+			{
+				pEnd = p;
+				if (*p == '\n') p++;
+				break;
+			}
+			const char *pChar = p;
+			uint8_t character;
+			if (!lcd.nextChar(p, character))
+			{
+				pEnd = pChar;
+				break;
+			}
+			uint8_t advance = lcd.getCharAdvance(character, size);
+			if (width + advance > box.w && pChar != pStart)
+			{
+				if (!wrap)
+				{
+					// one line per '\n' , skip what does not fit
+					pEnd = pChar;
+					while (*p != '\0' && *p != '\n') p++;
+					if (*p == '\n') p++;
+					cut = true;
+				} else if (*pChar == ' ')
+				{
+					pEnd = pChar;
+				} else if (pBreak != nullptr)
+				{
+					pEnd = pBreak;
+					p = pResume;
+					width = breakWidth;
+				} else
+				{
+					pEnd = pChar;
+					p = pChar;
+				}
+				break;
+			}
+			if (*pChar == ' ')
+			{
+				pBreak = pChar;
+				pResume = p;
+				breakWidth = width;
+			}
+			width += advance;
+		}
+		Line_t &line = _lines[_lineCount++];
+		line.start = pStart - pText;
+		line.length = pEnd - pStart;
+		line.width = width;
+		line.ellipsis = cut;
+		if (cut) _truncated = true;
+	}
+	if (*p != '\0' && _lineCount > 0)
+		_lines[_lineCount - 1].ellipsis = true;
+
+	uint16_t dotsWidth = ellipsis ? 3 * lcd.getCharAdvance('.', size) : 0;
+	for (uint8_t i = 0; i < _lineCount; i++)
+	{
+		Line_t &line = _lines[i];
+		if (line.ellipsis && dotsWidth == 0)
+			line.ellipsis = false;
+		if (line.ellipsis)
+		{
+			uint16_t width;
+			uint16_t maxWidth = (box.w > dotsWidth) ? box.w - dotsWidth : 0;
+			line.length = fitLine(lcd, pText + line.start, pText + line.start + line.length, maxWidth, width);
+			line.width = width + dotsWidth;
+		}
+		switch (align)
+		{
+			case LCD_AlignCenter: line.x = (line.width < box.w) ? (box.w - line.width) / 2 : 0; break;
+			case LCD_AlignRight: line.x = (line.width < box.w) ? box.w - line.width : 0; break;
+			default: line.x = 0; break;
+		}
+	}
+	return LCD_Success;
+}
+
+/*!
+	@brief Find how much of a run of text fits in a width
+	@param lcd The display
+	@param pStart First byte of text
+	@param pEnd One past the last byte of text
+	@param maxWidth Width available in pixels
+	@param width Returns the width of the text that fits
+	@return Number of bytes that fit
+*/
+uint16_t NOKIA_5110_TextLayout::fitLine(NOKIA_5110_graphics &lcd, const char *pStart, const char *pEnd, uint16_t maxWidth, uint16_t &width)
+{
+	const char *p = pStart;
+	const char *pFit = pStart;
+	uint8_t character;
+	width = 0;
+	while (p < pEnd && lcd.nextChar(p, character))
+	{
+		uint8_t advance = lcd.getCharAdvance(character, _size);
+		if (width + advance > maxWidth)
+			break;
+		width += advance;
+		pFit = p;
+	}
+	return pFit - pStart;
+}
+
+/*!
+	@brief Draw the laid out text
+	@param lcd The display , must have the font the text was laid out in
+	@param color foreground color
+	@param bg background color
+	@return LCD_Return_Codes_e
+*/
+LCD_Return_Codes_e NOKIA_5110_TextLayout::draw(NOKIA_5110_graphics &lcd, uint8_t color, uint8_t bg)
+{
+	if (_pText == nullptr)
+	{
+		return lcd.reportError(LCD_CharArrayNullptr, "Error TextLayout draw 1: Nothing laid out");
+	}
+	if (lcd.getFont() != _pFont)
+	{
+		return lcd.reportError(LCD_WrongFont, "Error TextLayout draw 2: Font is not the font text was laid out in");
+	}
+	static const char dots[] = "...";
+	for (uint8_t i = 0; i < _lineCount; i++)
+	{
+		const Line_t &line = _lines[i];
+		uint16_t x = _box.x + line.x;
+		uint16_t y = _box.y + i * _lineHeight;
+		drawRun(lcd, x, y, _pText + line.start, _pText + line.start + line.length, color, bg);
+		if (line.ellipsis)
+			drawRun(lcd, x, y, dots, dots + 3, color, bg);
+	}
+	return LCD_Success;
+}
+
+/*!
+	@brief Draw a run of text on one line
+	@param lcd The display
+	@param x x-co-ord start , moved to the end of the run
+	@param y y-co-ord
+	@param pStart First byte of text
+	@param pEnd One past the last byte of text
+	@param color foreground color
+	@param bg background color
+	@note Characters not in the font are skipped
+*/
+void NOKIA_5110_TextLayout::drawRun(NOKIA_5110_graphics &lcd, uint16_t &x, uint16_t y,
+	const char *pStart, const char *pEnd, uint8_t color, uint8_t bg)
+{
+	uint8_t character;
+	while (pStart < pEnd && lcd.nextChar(pStart, character))
+	{
+		if (lcd.getCharAdvance(character, _size) == 0)
+			continue; // not in font
+		drawGlyph(lcd, x, y, character, color, bg, _size);
+		x += lcd.getCharAdvance(character, _size);
+	}
+}
+
+/*!
+	@brief Get the number of lines laid out
+	@return Number of lines
+*/
+uint8_t NOKIA_5110_TextLayout::getLineCount() {return _lineCount;}
+
+/*!
+	@brief Get the width of the widest laid out line
+	@return Width in pixels
+*/
+uint16_t NOKIA_5110_TextLayout::getWidth()
+{
+	uint16_t width = 0;
+	for (uint8_t i = 0; i < _lineCount; i++)
+		if (_lines[i].width > width) width = _lines[i].width;
+	return width;
+}
+
+/*!
+	@brief Get the height of the laid out lines
+	@return Height in pixels
+*/
+uint16_t NOKIA_5110_TextLayout::getHeight() {return _lineCount * _lineHeight;}
+
+/*!
+	@brief Check if some of the text did not fit in the box
+	@return true if text was cut short or lines dropped
+*/
+bool NOKIA_5110_TextLayout::isTruncated() {return _truncated;}
+
+// Section: NOKIA_5110_TextField
+
+/*!
+	@brief constructor for NOKIA_5110_TextField class
+	@param box Box the field is drawn in , one line of text at its top ,
+		a box shorter than the line height is grown to it
+	@param pFont Font of the field , e.g. &LCDFontTable[LCDFont_Default] , must remain valid
+	@param align Horizontal alignment in box
+	@param color Text color
+	@param bg Background color , must differ from color
+	@param size Text size , fonts 1-6 only
+*/
+NOKIA_5110_TextField::NOKIA_5110_TextField(const LCD_Rect_t &box, const LCDFont_t *pFont, LCD_TextAlign_e align,
+	uint8_t color, uint8_t bg, uint8_t size) :
+	_box(box), _pFont(pFont), _align(align), _color(color), _bg(bg), _size(size ? size : 1)
+{
+}
+
+/*!
+	@brief Show a string in the field, drawing only what changed since the last call
+	@param lcd The display , its current font is kept , its text encoding is used
+	@param pText pointer to character array , not kept
+	@return LCD_Return_Codes_e
+	@note Characters not in the font are skipped
+*/
+LCD_Return_Codes_e NOKIA_5110_TextField::setText(NOKIA_5110_graphics &lcd, const char *pText)
+{
+	if (pText == nullptr)
+	{
+		return lcd.reportError(LCD_CharArrayNullptr, "Error TextField setText 1: String array is not valid pointer");
+	}
+	const LCDFont_t *pSavedFont = lcd.getFont();
+	if (lcd.SetFont(_pFont) != LCD_Success)
+		return LCD_FontInvalid;
+
+	uint8_t glyphs[LCD_FIELD_MAX_CHARS];
+	uint8_t count = 0;
+	uint16_t width = 0;
+	uint8_t character;
+	while (count < LCD_FIELD_MAX_CHARS && lcd.nextChar(pText, character))
+	{
+		uint8_t advance = lcd.getCharAdvance(character, _size);
+		if (advance == 0)
+			continue; // not in font
+		if (width + advance > _box.w)
+			break;
+		glyphs[count++] = character;
+		width += advance;
+	}
+
+	// glyphs are drawn at full height , so a box shorter than a line is grown to it
+	const uint8_t height = lcd.getLineHeight(_size);
+	if (!_valid)
+	{
+		lcd.fillRect(_box.x, _box.y, _box.w, height, _bg);
+		_count = 0;
+		_textWidth = 0;
+	}
+
+	// draw each glyph unless the same glyph is already at the same place
+	const uint16_t x0 = startX(width);
+	const uint16_t oldX0 = startX(_textWidth);
+	uint16_t x = x0, oldX = oldX0;
+	for (uint8_t i = 0; i < count; i++)
+	{
+		if (i >= _count || _glyphs[i] != glyphs[i] || oldX != x)
+			drawGlyph(lcd, x, _box.y, glyphs[i], _color, _bg, _size);
+		x += lcd.getCharAdvance(glyphs[i], _size);
+		if (i < _count) oldX += lcd.getCharAdvance(_glyphs[i], _size);
+	}
+
+	// clear the old text the new text does not cover
+	if (_textWidth > 0)
+	{
+		const uint16_t oldX1 = oldX0 + _textWidth;
+		const uint16_t x1 = x0 + width;
+		if (oldX0 < x0)
+			lcd.fillRect(oldX0, _box.y, LCD_min(x0, oldX1) - oldX0, height, _bg);
+		if (oldX1 > x1)
+		{
+			uint16_t start = (x1 > oldX0) ? x1 : oldX0;
+			lcd.fillRect(start, _box.y, oldX1 - start, height, _bg);
+		}
+	}
+	lcd.SetFont(pSavedFont);
+
+	memcpy(_glyphs, glyphs, count);
+	_count = count;
+	_textWidth = width;
+	_valid = true;
+	return LCD_Success;
+}
+
+/*!
+	@brief Forget what the field shows , the next setText clears the box and draws all of it
+	@note Call after the screen was cleared or drawn over
+*/
+void NOKIA_5110_TextField::invalidate() {_valid = false;}
+
+/*!
+	@brief Get the x co-ord text of a width starts at for the alignment
+	@param width Width of the text in pixels
+	@return x co-ord
+*/
+uint16_t NOKIA_5110_TextField::startX(uint16_t width)
+{
+	switch (_align)
+	{
+		case LCD_AlignCenter: return _box.x + (_box.w - width) / 2;
+		case LCD_AlignRight: return _box.x + _box.w - width;
+		default: return _box.x;
+	}
+}
+
+// Section: NOKIA_5110_Console
+
+/*!
+	@brief constructor for NOKIA_5110_Console class
+	@param lcd The display to draw on
+	@param box Box the console is drawn in
+	@param pFont Font of the console , e.g. &LCDFontTable[LCDFont_Default] , must remain valid
+	@param color Text color
+	@param bg Background color , must differ from color
+	@param size Text size , fonts 1-6 only
+	@note The box is cleared on the first write, or call clear().
+		At most LCD_CONSOLE_MAX_LINES - 1 lines are shown.
+*/
+NOKIA_5110_Console::NOKIA_5110_Console(NOKIA_5110_graphics &lcd, const LCD_Rect_t &box, const LCDFont_t *pFont,
+	uint8_t color, uint8_t bg, uint8_t size) :
+	_lcd(lcd), _box(box), _pFont(pFont), _color(color), _bg(bg), _size(size ? size : 1)
+{
+	_lineHeight = (pFont->layout == LCDFontLayout_SingleBank) ? pFont->height * _size : pFont->height;
+	// one line of history more than is shown , so a full box is seen to scroll
+	_rows = LCD_min(box.h / _lineHeight, LCD_CONSOLE_MAX_LINES - 1);
+	_lines[0].length = 0;
+}
+
+/*!
+	@brief called from the print class to write a byte to the console
+	@param character The byte
+	@return 1 if written , 0 if it could not be drawn
+*/
+size_t NOKIA_5110_Console::write(uint8_t character)
+{
+	return write(&character, 1);
+}
+
+/*!
+	@brief called from the print class to write a run of text to the console
+	@param buffer The bytes to write
+	@param size Number of bytes
+	@return Number of bytes written , less one for each character not in the font
+	@note Decoded as the display's write() does , UTF-8 if the display's setTextUTF8(true)
+*/
+size_t NOKIA_5110_Console::write(const uint8_t *buffer, size_t size)
+{
+	if (buffer == nullptr || _rows == 0)
+		return 0;
+	if (!_valid || _scrollBack > 0)
+	{
+		_scrollBack = 0;
+		redraw();
+	}
+	const LCDFont_t *pSavedFont = _lcd.getFont();
+	if (_lcd.SetFont(_pFont) != LCD_Success)
+		return 0;
+
+	size_t skipped = 0;
+	uint8_t character;
+	for (size_t n = 0; n < size; n++)
+	{
+		if (!_lcd.nextChar(buffer[n], _codePoint, _pending, character) || character == '\r')
+			continue;
+		if (character == '\n')
+		{
+			newLine();
+			continue;
+		}
+		uint8_t advance = _lcd.getCharAdvance(character, _size);
+		if (advance == 0)
+		{
+			skipped++;
+			continue;
+		}
+		if (_x + advance > _box.w || _lines[_head].length == LCD_CONSOLE_MAX_CHARS)
+			newLine();
+		Line_t &line = _lines[_head];
+		line.characters[line.length++] = character;
+		if (_scrollBack == 0)
+		{
+			uint8_t row = LCD_min(_count, _rows) - 1;
+			drawGlyph(_lcd, _box.x + _x, _box.y + row * _lineHeight, character, _color, _bg, _size);
+		}
+		_x += advance;
+	}
+	_lcd.SetFont(pSavedFont);
+	if (skipped > 0)
+		_lcd.reportError(LCD_CharFontASCIIRange, "Error Console write 1: Characters not in font skipped", skipped);
+	return size - skipped;
+}
+
+/*!
+	@brief Start a new line , scrolling the box up a line if it is full
+*/
+void NOKIA_5110_Console::newLine()
+{
+	_head = (_head + 1) % LCD_CONSOLE_MAX_LINES;
+	_lines[_head].length = 0;
+	_x = 0;
+	if (_count < LCD_CONSOLE_MAX_LINES)
+		_count++;
+	if (_count <= _rows)
+		return; // the new row is still blank
+
+	// move the bank bytes up a line and clear the bottom line , else draw it all again
+	if ((_box.y & 7) == 0 && (_lineHeight & 7) == 0 && _lcd.getRotation() == LCD_Degrees_0 &&
+		_lcd.scrollBanks(_box.x, _box.y / 8, _box.w, _rows * _lineHeight / 8, _lineHeight / 8))
+	{
+		_lcd.fillRect(_box.x, _box.y + (_rows - 1) * _lineHeight, _box.w, _lineHeight, _bg);
+	} else
+	{
+		redraw();
+	}
+}
+
+/*!
+	@brief Draw a line of the ring buffer , the console font must be set
+	@param row Row of the box to draw it in
+	@param line The line
+*/
+void NOKIA_5110_Console::drawLine(uint8_t row, const Line_t &line)
+{
+	uint16_t x = _box.x;
+	for (uint8_t i = 0; i < line.length; i++)
+	{
+		drawGlyph(_lcd, x, _box.y + row * _lineHeight, line.characters[i], _color, _bg, _size);
+		x += _lcd.getCharAdvance(line.characters[i], _size);
+	}
+}
+
+/*!
+	@brief Clear the box and draw the visible lines of the ring buffer
+	@note Call after the screen was cleared or drawn over
+*/
+void NOKIA_5110_Console::redraw()
+{
+	const LCDFont_t *pSavedFont = _lcd.getFont();
+	if (_lcd.SetFont(_pFont) != LCD_Success)
+		return;
+	_lcd.fillRect(_box.x, _box.y, _box.w, _box.h, _bg);
+	const uint8_t shown = LCD_min(_count - _scrollBack, _rows);
+	for (uint8_t row = 0; row < shown; row++)
+	{
+		uint8_t back = _scrollBack + shown - 1 - row;
+		drawLine(row, _lines[(_head + LCD_CONSOLE_MAX_LINES - back) % LCD_CONSOLE_MAX_LINES]);
+	}
+	_lcd.SetFont(pSavedFont);
+	_valid = true;
+}
+
+/*!
+	@brief Empty the ring buffer and clear the box
+*/
+void NOKIA_5110_Console::clear()
+{
+	_head = 0;
+	_count = 1;
+	_lines[0].length = 0;
+	_x = 0;
+	_scrollBack = 0;
+	redraw();
+}
+
+/*!
+	@brief Scroll the view back through the lines kept in the ring buffer
+	@param lines Lines to scroll back by , 0 to follow the newest line
+	@note Writing to the console returns the view to the newest line
+*/
+void NOKIA_5110_Console::setScrollBack(uint8_t lines)
+{
+	uint8_t most = (_count > _rows) ? _count - _rows : 0;
+	_scrollBack = LCD_min(lines, most);
+	redraw();
+}
+
+/*!
+	@brief Get the number of lines that fit in the box
+	@return rows
+*/
+uint8_t NOKIA_5110_Console::getRows() {return _rows;}
+
+/*!
+	@brief Get the number of lines in the ring buffer , including the one being written
+	@return lines
+*/
+uint8_t NOKIA_5110_Console::getLineCount() {return _count;}
+
+// Section: NOKIA_5110_Ticker
+
+/*!
+	@brief constructor for NOKIA_5110_Ticker class
+	@param x x co-ord of window in buffer
+	@param bank Bank (8 pixel row) of top of window
+	@param w Width of window in pixels
+	@param pFont Font of the ticker , e.g. &LCDFontTable[LCDFont_Default] , must remain valid
+	@param color Text color , the background is the other color
+	@param gap Blank columns after the text before it repeats
+*/
+NOKIA_5110_Ticker::NOKIA_5110_Ticker(uint8_t x, uint8_t bank, uint8_t w, const LCDFont_t *pFont, uint8_t color, uint8_t gap) :
+	_x(x), _bank(bank), _w(w), _pFont(pFont), _color(color), _gap(gap)
+{
+}
+
+/*!
+	@brief Render a string into the strip and start it at the left of the window
+	@param lcd The display , its text encoding is used
+	@param pText pointer to character array , not kept
+	@return LCD_Return_Codes_e
+	@note Characters not in the font are skipped
+*/
+LCD_Return_Codes_e NOKIA_5110_Ticker::setText(NOKIA_5110_graphics &lcd, const char *pText)
+{
+	if (pText == nullptr)
+		return lcd.reportError(LCD_CharArrayNullptr, "Error Ticker setText 1: String array is not valid pointer");
+	const LCDFont_t *pSavedFont = lcd.getFont();
+	if (lcd.SetFont(_pFont) != LCD_Success)
+		return LCD_FontInvalid;
+
+	const bool singleBank = (_pFont->layout == LCDFontLayout_SingleBank);
+	_banks = (_pFont->height + 7) / 8;
+	_length = lcd.measureText(pText) + _gap;
+	if (_length == 0) _length = 1;
+	_strip.assign(_banks * _length, 0x00);
+
+	uint16_t x = 0;
+	uint8_t character;
+	const char *p = pText;
+	while (lcd.nextChar(p, character))
+	{
+		uint8_t width;
+		if (lcd.getCharWidth(character) == 0)
+			continue;
+		const uint8_t *pGlyph = lcd.getGlyph(character, width);
+		for (uint8_t k = 0; k < _banks; k++)
+			memcpy(&_strip[k * _length + x], pGlyph + k * width, width);
+		x += width + (singleBank ? 1 : 0);
+	}
+	lcd.SetFont(pSavedFont);
+
+	if (_color == 0)
+		for (uint8_t &column : _strip) column = ~column;
+	_window.resize(_banks * _w);
+	_offset = 0;
+	return draw(lcd);
+}
+
+/*!
+	@brief Move the text along and draw the window
+	@param lcd The display
+	@param pixels Columns to move by , positive scrolls the text left
+	@return LCD_Return_Codes_e
+*/
+LCD_Return_Codes_e NOKIA_5110_Ticker::step(NOKIA_5110_graphics &lcd, int16_t pixels)
+{
+	if (_length == 0)
+		return lcd.reportError(LCD_CharArrayNullptr, "Error Ticker step 1: No text set");
+	int32_t offset = ((int32_t)_offset + pixels) % _length;
+	_offset = (offset < 0) ? offset + _length : offset;
+	return draw(lcd);
+}
+
+/*!
+	@brief Copy the window of the strip at the current offset into the buffer
+	@param lcd The display
+	@return LCD_Return_Codes_e
+*/
+LCD_Return_Codes_e NOKIA_5110_Ticker::draw(NOKIA_5110_graphics &lcd)
+{
+	if (_length == 0)
+		return lcd.reportError(LCD_CharArrayNullptr, "Error Ticker draw 1: No text set");
+	// a font not a multiple of 8 high leaves the rows below it in the last bank alone
+	uint8_t lastMask = (_pFont->height % 8) ? (1 << (_pFont->height % 8)) - 1 : 0xFF;
+	if (_offset + _w <= _length)
+		return lcd.copyBanks(&_strip[_offset], _length, _x, _bank, _w, _banks, lastMask);
+
+	// window runs off the end of the strip , assemble it from the start again
+	for (uint8_t k = 0; k < _banks; k++)
+	{
+		const uint8_t *pRow = &_strip[k * _length];
+		uint16_t column = _offset;
+		for (uint8_t i = 0; i < _w; )
+		{
+			uint16_t run = LCD_min((uint16_t)(_length - column), (uint16_t)(_w - i));
+			memcpy(&_window[k * _w + i], pRow + column, run);
+			i += run;
+			column = 0;
+		}
+	}
+	return lcd.copyBanks(_window.data(), _w, _x, _bank, _w, _banks, lastMask);
+}
+
+/*!
+	@brief Set the strip column at the left of the window , drawn on next step or draw
+	@param offset Column
+*/
+void NOKIA_5110_Ticker::setOffset(uint16_t offset) {_offset = _length ? offset % _length : 0;}
+
+/*!
+	@brief Get the strip column at the left of the window
+	@return offset
+*/
+uint16_t NOKIA_5110_Ticker::getOffset() {return _offset;}
+
+/*!
+	@brief Get the width of the strip , text plus gap , one full cycle of the marquee
+	@return Length in pixels
+*/
+uint16_t NOKIA_5110_Ticker::getLength() {return _length;}
+
+// Section: NOKIA_5110_StripChart
+
+/*!
+	@brief constructor for NOKIA_5110_StripChart class
+	@param box Box the chart is drawn in , unrotated buffer co-ordinates
+	@param minValue Value at bottom of box
+	@param maxValue Value at top of box
+	@param autoScale The range follows the samples held , minValue and maxValue are the start range
+	@param fill Fill below the plot , else the samples are joined by vertical spans
+	@param color Plot color , the background is the other color
+*/
+NOKIA_5110_StripChart::NOKIA_5110_StripChart(const LCD_Rect_t &box, float minValue, float maxValue,
+	bool autoScale, bool fill, uint8_t color) :
+	_x(box.x), _y(box.y), _w(box.w), _h(box.h), _min(minValue), _max(maxValue),
+	_autoScale(autoScale), _fill(fill), _color(color)
+{
+	_samples.assign(_w + 1, 0.0f);
+}
+
+/*!
+	@brief Add a sample , the plot moves one column left and the new column is drawn
+	@param lcd The display
+	@param value The sample
+*/
+void NOKIA_5110_StripChart::addSample(NOKIA_5110_graphics &lcd, float value)
+{
+	if (_w == 0 || _h == 0)
+		return;
+	const uint16_t capacity = _samples.size();
+	_samples[_next] = value;
+	_next = (_next + 1) % capacity;
+	if (_count < capacity) _count++;
+
+	if ((_autoScale && rescale()) || !_valid)
+	{
+		redraw(lcd);
+		return;
+	}
+	lcd.scroll({_x, _y, _w, _h}, -1, 0, !_color);
+	uint8_t previousY = valueToY(_samples[(_next + capacity - 2) % capacity]);
+	drawColumn(lcd, _w - 1, valueToY(value), (_count > 1) ? previousY : valueToY(value));
+}
+
+/*!
+	@brief Clear the box and draw all the samples held
+	@param lcd The display
+*/
+void NOKIA_5110_StripChart::redraw(NOKIA_5110_graphics &lcd)
+{
+	lcd.fillBufferRect(_x, _y, _w, _h, !_color);
+	// one more sample than columns is held , so the left column joins the one before it
+	const uint16_t capacity = _samples.size();
+	uint16_t index = (_next + capacity - _count) % capacity;
+	uint8_t previousY = valueToY(_samples[index]);
+	for (uint16_t i = 0; i < _count; i++)
+	{
+		uint8_t y = valueToY(_samples[index]);
+		if (i + _w >= _count)
+			drawColumn(lcd, _w - _count + i, y, previousY);
+		previousY = y;
+		index = (index + 1) % capacity;
+	}
+	_valid = true;
+}
+
+/*!
+	@brief Remove all samples and clear the box
+	@param lcd The display
+*/
+void NOKIA_5110_StripChart::clear(NOKIA_5110_graphics &lcd)
+{
+	_count = 0;
+	_next = 0;
+	redraw(lcd);
+}
+
+/*!
+	@brief Set the range of the chart and redraw it
+	@param lcd The display
+	@param minValue Value at bottom of box
+	@param maxValue Value at top of box
+	@note With auto scale this is the range until a sample falls outside it
+*/
+void NOKIA_5110_StripChart::setRange(NOKIA_5110_graphics &lcd, float minValue, float maxValue)
+{
+	_min = minValue;
+	_max = maxValue;
+	redraw(lcd);
+}
+
+/*!
+	@brief Get the value at the bottom of the box
+	@return Minimum of range
+*/
+float NOKIA_5110_StripChart::getMin() {return _min;}
+
+/*!
+	@brief Get the value at the top of the box
+	@return Maximum of range
+*/
+float NOKIA_5110_StripChart::getMax() {return _max;}
+
+/*!
+	@brief Get the number of samples held , at most the box width plus one
+	@return Sample count
+*/
+uint16_t NOKIA_5110_StripChart::getSampleCount() {return _count;}
+
+/*!
+	@brief Fit the range to the samples held
+	@return true if the range changed
+	@details The range changes when a sample falls outside it, or the samples span less
+		than half of it. The new range is the samples' span plus an eighth either side,
+		so small changes in the data do not cause a redraw every sample.
+*/
+bool NOKIA_5110_StripChart::rescale()
+{
+	const uint16_t capacity = _samples.size();
+	float low = _samples[(_next + capacity - 1) % capacity];
+	float high = low;
+	for (uint16_t i = 0; i < _count; i++)
+	{
+		float value = _samples[(_next + capacity - _count + i) % capacity];
+		if (value < low) low = value;
+		if (value > high) high = value;
+	}
+	if (low >= _min && high <= _max && (high - low) * 2 >= (_max - _min))
+		return false;
+	float margin = (high > low) ? (high - low) / 8 : 1.0f;
+	// a flat signal fails the span test every sample , its range does not change
+	if (_min == low - margin && _max == high + margin)
+		return false;
+	_min = low - margin;
+	_max = high + margin;
+	return true;
+}
+
+/*!
+	@brief Convert a value to a row of the box , clamped to the box
+	@param value The sample
+	@return y co-ord in buffer
+*/
+uint8_t NOKIA_5110_StripChart::valueToY(float value)
+{
+	if (!(_max > _min) || value <= _min)
+		return _y + _h - 1;
+	if (value >= _max)
+		return _y;
+	return _y + _h - 1 - (uint8_t)((value - _min) * (_h - 1) / (_max - _min) + 0.5f);
+}
+
+/*!
+	@brief Draw the plot in one column of the box , as one vertical span
+	@param lcd The display
+	@param column Column of box
+	@param y Row of the sample in this column
+	@param previousY Row of the sample in the column before , the span joins them
+*/
+void NOKIA_5110_StripChart::drawColumn(NOKIA_5110_graphics &lcd, uint8_t column, uint8_t y, uint8_t previousY)
+{
+	uint8_t top = _fill ? y : LCD_min(y, previousY);
+	uint8_t bottom = _fill ? (_y + _h - 1) : ((y > previousY) ? y : previousY);
+	lcd.fillBufferRect(_x + column, top, 1, bottom - top + 1, _color);
+}
+
+// Section: NOKIA_5110_Bar
+
+/*!
+	@brief constructor for NOKIA_5110_Bar class
+	@param box Box the bar is drawn in , unrotated buffer co-ordinates , including any border
+	@param minValue Value of an empty bar
+	@param maxValue Value of a full bar
+	@param vertical Bar fills upwards , else left to right
+	@param border Draw a border with a one pixel gap inside it
+	@param segments Number of segments , 0 for a solid bar
+	@param color Bar color , the background is the other color
+*/
+NOKIA_5110_Bar::NOKIA_5110_Bar(const LCD_Rect_t &box, float minValue, float maxValue, bool vertical,
+	bool border, uint8_t segments, uint8_t color) :
+	_box(box), _min(minValue), _max(maxValue), _vertical(vertical), _border(border),
+	_segments(segments), _color(color), _value(minValue)
+{
+	uint8_t inset = border ? 2 : 0;
+	_x = box.x + inset;
+	_y = box.y + inset;
+	_w = (box.w > 2 * inset) ? box.w - 2 * inset : 0;
+	_h = (box.h > 2 * inset) ? box.h - 2 * inset : 0;
+	_length = vertical ? _h : _w;
+	if (_segments > _length / 2) _segments = _length / 2;
+	if (_segments) _pitch = (_length + 1) / _segments;
+}
+
+/*!
+	@brief Set the value , only the span between the old and new level is drawn
+	@param lcd The display
+	@param value The value , clamped to the range
+*/
+void NOKIA_5110_Bar::setValue(NOKIA_5110_graphics &lcd, float value)
+{
+	_value = value;
+	uint8_t filled = valueToLength(value);
+	if (!_valid)
+	{
+		_filled = filled;
+		redraw(lcd);
+		return;
+	}
+	if (filled > _filled)
+		drawSpan(lcd, _filled, filled, true);
+	else if (filled < _filled)
+		drawSpan(lcd, filled, _filled, false);
+	_filled = filled;
+}
+
+/*!
+	@brief Draw the whole bar , border and all
+	@param lcd The display
+*/
+void NOKIA_5110_Bar::redraw(NOKIA_5110_graphics &lcd)
+{
+	if (_border && _box.w > 0 && _box.h > 0)
+	{
+		lcd.fillBufferRect(_box.x, _box.y, _box.w, _box.h, _color);
+		// a box of 2 pixels or less is all border , there is no inside to clear
+		if (_box.w > 2 && _box.h > 2)
+			lcd.fillBufferRect(_box.x + 1, _box.y + 1, _box.w - 2, _box.h - 2, !_color);
+	}
+	drawSpan(lcd, 0, _length, false);
+	drawSpan(lcd, 0, _filled, true);
+	_valid = true;
+}
+
+/*!
+	@brief Get the last value set
+	@return value
+*/
+float NOKIA_5110_Bar::getValue() {return _value;}
+
+/*!
+	@brief Convert a value to a filled length , whole segments for a gauge
+	@param value The value
+	@return Pixels filled along the bar
+*/
+uint8_t NOKIA_5110_Bar::valueToLength(float value)
+{
+	if (!(_max > _min) || value <= _min)
+		return 0;
+	float fraction = (value >= _max) ? 1.0f : (value - _min) / (_max - _min);
+	if (_segments)
+		return (uint8_t)(fraction * _segments + 0.5f) * _pitch;
+	return (uint8_t)(fraction * _length + 0.5f);
+}
+
+/*!
+	@brief Fill or clear a span of the bar
+	@param lcd The display
+	@param from First pixel along the bar
+	@param to One past the last pixel along the bar
+	@param on Fill with the bar color , else clear
+	@note Gaps between segments are left clear.
+*/
+void NOKIA_5110_Bar::drawSpan(NOKIA_5110_graphics &lcd, uint8_t from, uint8_t to, bool on)
+{
+	if (to > _length) to = _length;
+	while (from < to)
+	{
+		uint8_t end = to;
+		if (_pitch && on)
+		{
+			uint8_t segmentEnd = (from / _pitch) * _pitch + _pitch - 1; // first gap pixel
+			if (from >= segmentEnd) { from = segmentEnd + 1; continue; }
+			if (end > segmentEnd) end = segmentEnd;
+		}
+		if (_vertical)
+			lcd.fillBufferRect(_x, _y + _h - end, _w, end - from, on ? _color : !_color);
+		else
+			lcd.fillBufferRect(_x + from, _y, end - from, _h, on ? _color : !_color);
+		from = end;
+	}
+}
+
+// ********************** EOF *********************
@@ -5,6 +5,11 @@
 * @details <https://github.com/gavinlyonsrepo/NOKIA_5110_RPI>
 */
 
+#include <algorithm>
+#include <math.h>
+#include <thread>
+#include <vector>
+
 #include "NOKIA_5110_graphics.hpp"
 #include "NOKIA_5110_RPI.hpp"
 
@@ -13,64 +18,169 @@
 */
 NOKIA_5110_graphics::NOKIA_5110_graphics()
 {
+	clearDirty();
+	clearErrorCounts();
+}
+
+/*!
+	@brief The default error callback , prints the message to the console
+	@param code The error code
+	@param message The error message
+*/
+void NOKIA_5110_graphics::printError(LCD_Return_Codes_e code, const char *message)
+{
+	(void)code;
+	std::cout << message << '\n';
+}
+
+/*!
+	@brief Set the function errors are reported to
+	@param callback The function , nullptr for no reporting (errors are still counted)
+	@note The default is printError, which prints to the console
+*/
+void NOKIA_5110_graphics::setErrorCallback(LCD_ErrorCallback_t callback)
+{
+	_errorCallback = callback;
+}
+
+/*!
+	@brief Count an error and pass it to the error callback
+	@param code The error code
+	@param message The error message
+	@param count Number of errors , e.g. characters skipped in a run
+	@return code
+	@note Used by the library and the widget classes
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::reportError(LCD_Return_Codes_e code, const char *message, uint16_t count)
+{
+	if (code < LCD_RETURN_CODES)
+		_errorCounts[code] += count;
+	if (_errorCallback != nullptr)
+		_errorCallback(code, message);
+	return code;
+}
+
+/*!
+	@brief Get the number of times an error has been reported
+	@param code The error code
+	@return count since start or clearErrorCounts
+*/
+uint32_t NOKIA_5110_graphics::getErrorCount(LCD_Return_Codes_e code)
+{
+	return (code < LCD_RETURN_CODES) ? _errorCounts[code] : 0;
+}
+
+/*!
+	@brief Set all error counts to zero
+*/
+void NOKIA_5110_graphics::clearErrorCounts()
+{
+	memset(_errorCounts, 0, sizeof(_errorCounts));
+}
+
+/*!
+	@brief Feed one byte to a UTF-8 decoder
+	@param byte Next byte of text
+	@param codePoint Holds the code point being decoded, returns the code point when complete
+	@param pending Continuation bytes still expected , 0 at the start of text
+	@return true when codePoint holds a complete code point
+	@note A sequence broken by a new lead byte is dropped , a stray byte decodes as U+FFFD
+*/
+static bool decodeUTF8(uint8_t byte, uint32_t &codePoint, uint8_t &pending)
+{
+	if (pending > 0 && (byte & 0xC0) == 0x80)
+	{
+		codePoint = (codePoint << 6) | (byte & 0x3F);
+		return --pending == 0;
+	}
+	pending = 0;
+	if (byte < 0x80)
+	{
+		codePoint = byte;
+		return true;
+	}
+	if ((byte & 0xE0) == 0xC0) { codePoint = byte & 0x1F; pending = 1; return false; }
+	if ((byte & 0xF0) == 0xE0) { codePoint = byte & 0x0F; pending = 2; return false; }
+	if ((byte & 0xF8) == 0xF0) { codePoint = byte & 0x07; pending = 3; return false; }
+	codePoint = 0xFFFD;
+	return true;
 }
 
 /*!
 	@brief called from the print class to wrap drawText functions
+	@param character The byte to write
+	@return 1 if written or a control byte , 0 if it could not be drawn
+	@note if setTextUTF8(true) the bytes are decoded as UTF-8, see setTextUTF8
 */
 size_t NOKIA_5110_graphics::write(uint8_t character)
 {
-	int DrawCharReturnCode;
-	if (_FontNumber < LCDFont_Bignum)
+	return write(&character, 1);
+}
+
+/*!
+	@brief called from the print class to draw a run of text at the cursor
+	@param buffer The bytes to write
+	@param size Number of bytes
+	@return Number of bytes written , less one for each character that could not be drawn
+	@details The font family is looked up once for the run , then each glyph is checked
+		against the font and screen and drawn without the per character checks of drawChar.
+		'\n' moves to the start of the next line , '\r' is skipped , text wraps if setTextWrap(true).
+		Characters that cannot be drawn are skipped and reported once per run.
+*/
+size_t NOKIA_5110_graphics::write(const uint8_t *buffer, size_t size)
+{
+	if (buffer == nullptr)
+		return 0;
+	const bool singleBank = (_pCurrentFont->layout == LCDFontLayout_SingleBank);
+	const uint8_t lineHeight = getLineHeight(_textSize);
+	const int16_t wrapX = _width - (singleBank ? _textSize * (_CurrentFontWidth + 1) : (_CurrentFontWidth + 1));
+	size_t skipped = 0;
+
+	for (size_t n = 0; n < size; n++)
 	{
-		switch (character)
+		uint8_t character;
+		if (!nextChar(buffer[n], _utf8CodePoint, _utf8Pending, character))
+			continue;
+		if (character == '\n')
 		{
-		case '\n':
-			_cursorY += _textSize*_CurrentFontheight;
-			_cursorX  = 0;
-		break;
-		case'\r':/* skip */ break;
-		default:
-				DrawCharReturnCode = drawChar(_cursorX, _cursorY, character, _textColor, _textBgColor, _textSize) ;
-				if(DrawCharReturnCode  != LCD_Success)
-				{
-					std::cout<< "Error write_print method 1: Method drawChar failed" << DrawCharReturnCode << std::endl;
-					return DrawCharReturnCode;
-				}
-			_cursorX += _textSize*(_CurrentFontWidth+1);
-				if (_textWrap && (_cursorX > (_width - _textSize*(_CurrentFontWidth+1))))
-				{
-					_cursorY += _textSize*_CurrentFontheight;
-					_cursorX = 0;
-				}
-		break;
+			_cursorY += lineHeight;
+			_cursorX = 0;
+			continue;
 		}
-	}else // for font numbers 7-10
-	{
-		switch (character)
+		if (character == '\r')
+			continue;
+
+		uint8_t advance = getCharAdvance(character, _textSize);
+		if (singleBank)
+		{
+			if (advance == 0 || (uint16_t)_cursorX >= _width || (uint16_t)_cursorY >= _height)
+			{
+				skipped++;
+				continue;
+			}
+			drawCharUnchecked((uint16_t)_cursorX, (uint16_t)_cursorY, character, _textColor, _textBgColor, _textSize);
+		} else
+		{
+			if (advance == 0 || (uint8_t)_cursorX >= _width || (uint8_t)_cursorY >= _height)
+			{
+				skipped++;
+				continue;
+			}
+			drawCharUnchecked((uint8_t)_cursorX, (uint8_t)_cursorY, character, _textColor, _textBgColor);
+		}
+		_cursorX += advance;
+		if (_textWrap && _cursorX > wrapX)
 		{
-			case '\n':
-				_cursorY += _CurrentFontheight;
-				_cursorX  = 0;
-			break;
-			case '\r': /* skip */  break;
-			default:
-				DrawCharReturnCode = drawChar(_cursorX, _cursorY, character, _textColor, _textBgColor) ;
-				if(DrawCharReturnCode  != LCD_Success)
-				{
-					std::cout<< "Error write_print method 2 : Method drawChar failed" << DrawCharReturnCode << std::endl;
-					return DrawCharReturnCode;
-				}
-				_cursorX += (_CurrentFontWidth);
-				if (_textWrap && (_cursorX  > (_width - (_CurrentFontWidth+1))))
-				{
-					_cursorY += _CurrentFontheight;
-					_cursorX = 0;
-				}
-			break;
-		} // end of switch
-	} // end of else
-  return 1;
+			_cursorY += lineHeight;
+			_cursorX = 0;
+		}
+	}
+	if (skipped > 0)
+	{
+		setWriteError();
+		reportError(LCD_CharFontASCIIRange, "Error write_print method 1: Characters out of font or screen bounds skipped", skipped);
+	}
+	return size - skipped;
 }
 
 /*!
@@ -118,6 +228,76 @@ void NOKIA_5110_graphics::drawLine_2(uint16_t x0, uint16_t y0, uint16_t x1, uint
 	}
 }
 
+/*!
+	@brief Draw a batch of pixels , e.g. a scatter plot or star field
+	@param points The pixels , screen co-ordinates , off screen points are skipped
+	@param count Number of points
+	@param color color of pixels
+	@return LCD_Return_Codes_e
+	@details The rotation is worked out once for the batch, as an affine map to buffer
+		co-ordinates. Each point sets a bit in a mask per buffer byte, then the masks are
+		ORed or AND NOTed into the buffer in buffer order, each byte written once.
+		Only changed bytes are marked dirty. Without a buffer LCDDrawPixel is used.
+		The masks take 504 bytes of stack , a buffer larger than 84x48 uses the heap.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::drawPixels(const LCD_Point_t *points, size_t count, uint8_t color)
+{
+	if (count == 0)
+		return LCD_Success;
+	if (points == nullptr)
+		return reportError(LCD_BitmapNullptr, "Error drawPixels 1: Points is not valid pointer");
+	if (_buffer == nullptr)
+	{
+		// LCDDrawPixel takes uint8_t , skip points it would wrap back on screen
+		for (size_t i = 0; i < count; i++)
+			if (points[i].x >= 0 && points[i].x <= 255 && points[i].y >= 0 && points[i].y <= 255)
+				LCDDrawPixel(points[i].x, points[i].y, color);
+		return LCD_Success;
+	}
+
+	// buffer x = x0 + xx*x + xy*y , buffer y = y0 + yx*x + yy*y
+	int16_t x0 = 0, xx = 1, xy = 0, y0 = 0, yx = 0, yy = 1;
+	switch (_LCD_rotate) {
+	case LCD_Degrees_90:  xx = 0; xy = 1; y0 = _bufferHeight - 1; yx = -1; yy = 0; break;
+	case LCD_Degrees_180: x0 = _bufferWidth - 1; xx = -1; y0 = _bufferHeight - 1; yy = -1; break;
+	case LCD_Degrees_270: x0 = _bufferWidth - 1; xx = 0; xy = -1; yx = 1; yy = 0; break;
+	default: break;
+	}
+
+	// a 84x48 buffer uses the stack block , a larger one a heap block of its size
+	const uint16_t size = _bufferWidth * (_bufferHeight / 8);
+	uint8_t localMasks[LCDWIDTH * LCDHEIGHT / 8];
+	std::vector<uint8_t> heapMasks;
+	uint8_t *masks = localMasks;
+	if (size > sizeof(localMasks))
+	{
+		heapMasks.resize(size);
+		masks = heapMasks.data();
+	}
+	memset(masks, 0, size);
+	for (size_t i = 0; i < count; i++)
+	{
+		uint16_t x = x0 + xx * points[i].x + xy * points[i].y;
+		uint16_t y = y0 + yx * points[i].x + yy * points[i].y;
+		if (x < _bufferWidth && y < _bufferHeight)
+			masks[(y >> 3) * _bufferWidth + x] |= 1 << (y & 7);
+	}
+
+	for (uint16_t index = 0; index < size; index++)
+	{
+		uint8_t mask = masks[index];
+		if (mask == 0)
+			continue;
+		uint8_t value = color ? (_buffer[index] | mask) : (_buffer[index] & ~mask);
+		if (value != _buffer[index])
+		{
+			_buffer[index] = value;
+			markDirtyByte(index % _bufferWidth, index / _bufferWidth);
+		}
+	}
+	return LCD_Success;
+}
+
 /*!
 	@brief drawHLine
 	@param x x-co-ord
@@ -126,6 +306,15 @@ void NOKIA_5110_graphics::drawLine_2(uint16_t x0, uint16_t y0, uint16_t x1, uint
 	@param color
 */
 void NOKIA_5110_graphics::drawHLine(uint8_t x, uint8_t y, uint8_t w, bool color) {
+	if (w == 0)
+		return;
+	// Fast path, a masked byte per column , clipped as LCDDrawPixel clips
+	if (_buffer != nullptr && _LCD_rotate == LCD_Degrees_0 && x + w <= 256)
+	{
+		if (x < _width && y < _height)
+			fillBufferRect(x, y, LCD_min(w, _width - x), 1, color);
+		return;
+	}
 	 drawLine_2(x, y, x + w - 1, y, color);
 }
 
@@ -137,6 +326,15 @@ void NOKIA_5110_graphics::drawHLine(uint8_t x, uint8_t y, uint8_t w, bool color)
 	@param color
 */
 void NOKIA_5110_graphics::drawVLine(uint8_t x, uint8_t y, uint8_t h, bool color) {
+	if (h == 0)
+		return;
+	// Fast path, one byte mask per bank the line crosses
+	if (_buffer != nullptr && _LCD_rotate == LCD_Degrees_0 && y + h <= 256)
+	{
+		if (x < _width && y < _height)
+			fillBufferRect(x, y, 1, LCD_min(h, _height - y), color);
+		return;
+	}
 	drawLine_2(x, y, x, y + h - 1, color);
 }
 
@@ -149,6 +347,13 @@ void NOKIA_5110_graphics::drawVLine(uint8_t x, uint8_t y, uint8_t h, bool color)
 	@param color
 */
 void NOKIA_5110_graphics::fillRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color) {
+	// Fast path, a bank at a time with a byte mask for the top and bottom banks
+	if (_buffer != nullptr && _LCD_rotate == LCD_Degrees_0 && h != 0 && y + h <= 256)
+	{
+		if (w != 0 && x < _width && y < _height)
+			fillBufferRect(x, y, LCD_min(w, _width - x), LCD_min(h, _height - y), color);
+		return;
+	}
 	uint8_t i;
 	for (i = x; i < x + w; i++)
 	drawVLine(i, y, h, color);
@@ -224,6 +429,134 @@ void NOKIA_5110_graphics::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16
 }
 
 
+/*! Span tables of the circles up to LCD_CIRCLE_TABLE_MAX radius , built at compile time.
+	For radius r and column offset dx from the centre, 0 to r, the outline covers row offsets
+	low to high above and below the centre, and the filled circle covers -high to +high.
+	The tables are the pixels of the midpoint circle that drawCircle plotted a pixel at a time. */
+struct CircleSpans_t
+{
+	uint8_t low[(LCD_CIRCLE_TABLE_MAX + 1) * (LCD_CIRCLE_TABLE_MAX + 2) / 2];  /**< Nearest outline row to centre */
+	uint8_t high[(LCD_CIRCLE_TABLE_MAX + 1) * (LCD_CIRCLE_TABLE_MAX + 2) / 2]; /**< Furthest outline row from centre */
+};
+
+/*!
+	@brief Build the circle span tables
+	@return The tables , row offsets of radius r start at r*(r+1)/2
+*/
+static constexpr CircleSpans_t makeCircleSpans()
+{
+	CircleSpans_t spans{};
+	for (int16_t r = 0; r <= LCD_CIRCLE_TABLE_MAX; r++)
+	{
+		uint16_t base = r * (r + 1) / 2;
+		for (int16_t i = 0; i <= r; i++)
+		{
+			spans.low[base + i] = 0xFF;
+			spans.high[base + i] = 0;
+		}
+		int16_t f = 1 - r, ddF_x = 1, ddF_y = -2 * r, x = 0, y = r;
+		// the points of one octant and their mirror in the diagonal
+		auto plot = [&spans, base](int16_t column, int16_t row)
+		{
+			if (row < spans.low[base + column]) spans.low[base + column] = row;
+			if (row > spans.high[base + column]) spans.high[base + column] = row;
+		};
+		plot(0, r);
+		plot(r, 0);
+		while (x < y)
+		{
+			if (f >= 0)
+			{
+				y--;
+				ddF_y += 2;
+				f += ddF_y;
+			}
+			x++;
+			ddF_x += 2;
+			f += ddF_x;
+			plot(x, y);
+			plot(y, x);
+		}
+	}
+	return spans;
+}
+
+static constexpr CircleSpans_t circleSpans = makeCircleSpans(); /**< Circle span tables */
+
+/*!
+	@brief Draw a vertical span of pixels , clipped to the screen
+	@param x x co-ord
+	@param y0 y co-ord of top of span
+	@param y1 y co-ord of bottom of span
+	@param color color of span
+	@note Not rotated, a byte mask per bank is written straight to the buffer
+*/
+void NOKIA_5110_graphics::drawColumnSpan(int32_t x, int32_t y0, int32_t y1, uint8_t color)
+{
+	if (x < 0 || x >= _width || y1 < 0 || y0 >= _height || y0 > y1)
+		return;
+	if (y0 < 0) y0 = 0;
+	if (y1 >= _height) y1 = _height - 1;
+	if (_buffer == nullptr || _LCD_rotate != LCD_Degrees_0)
+	{
+		drawVLine(x, y0, y1 - y0 + 1, color);
+		return;
+	}
+	const uint8_t firstBank = y0 >> 3, lastBank = y1 >> 3;
+	uint8_t *pByte = &_buffer[firstBank * _bufferWidth + x];
+	for (uint8_t bank = firstBank; bank <= lastBank; bank++, pByte += _bufferWidth)
+	{
+		uint8_t mask = 0xFF;
+		if (bank == firstBank) mask &= 0xFF << (y0 & 7);
+		if (bank == lastBank) mask &= 0xFF >> (7 - (y1 & 7));
+		uint8_t value = color ? (*pByte | mask) : (*pByte & ~mask);
+		if (value != *pByte)
+		{
+			*pByte = value;
+			markDirtyByte(x, bank);
+		}
+	}
+}
+
+/*!
+	@brief Draw part of a circle from the span tables , a column at a time
+	@param left x co-ord of centre of the left half
+	@param right x co-ord of centre of the right half , right of left for round rects
+	@param top y co-ord of centre of the upper half
+	@param bottom y co-ord of centre of the lower half , below top for round rects
+	@param r Radius , at most LCD_CIRCLE_TABLE_MAX
+	@param corners Quarters to draw , 1 top right , 2 top left , 4 bottom right , 8 bottom left ,
+		a fill draws the right half for 1 and the left half for 2
+	@param fill Fill each column from top to bottom , else the outline
+	@param color color
+	@note The quarters leave out their centre column and row, those are the straight
+		sides of a round rect, so r is at least 2 for an outline. A full circle passes
+		the same centre for all four and draws the centre column and row itself.
+*/
+void NOKIA_5110_graphics::drawCircleSpans(int32_t left, int32_t right, int32_t top, int32_t bottom,
+	uint8_t r, uint8_t corners, bool fill, uint8_t color)
+{
+	const uint8_t *pLow = &circleSpans.low[r * (r + 1) / 2];
+	const uint8_t *pHigh = &circleSpans.high[r * (r + 1) / 2];
+	for (uint8_t dx = 1; dx <= r; dx++)
+	{
+		int32_t high = pHigh[dx];
+		int32_t low = pLow[dx] ? pLow[dx] : 1;
+		if (fill)
+		{
+			if (corners & 1) drawColumnSpan(right + dx, top - high, bottom + high, color);
+			if (corners & 2) drawColumnSpan(left - dx, top - high, bottom + high, color);
+			continue;
+		}
+		if (low > high)
+			continue;
+		if (corners & 1) drawColumnSpan(right + dx, top - high, top - low, color);
+		if (corners & 2) drawColumnSpan(left - dx, top - high, top - low, color);
+		if (corners & 4) drawColumnSpan(right + dx, bottom + low, bottom + high, color);
+		if (corners & 8) drawColumnSpan(left - dx, bottom + low, bottom + high, color);
+	}
+}
+
 /*!
 	@brief   Draw a circle outline
 	@param    x0   Center-point x coordinate
@@ -232,6 +565,15 @@ void NOKIA_5110_graphics::drawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16
 	@param    color
 */
 void NOKIA_5110_graphics::drawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint8_t color) {
+	if (r <= LCD_CIRCLE_TABLE_MAX)
+	{
+		drawColumnSpan(x0, y0 - r, y0 - r, color);
+		drawColumnSpan(x0, y0 + r, y0 + r, color);
+		drawCircleSpans(x0, x0, y0, y0, r, 0x0F, false, color);
+		drawColumnSpan(x0 - r, y0, y0, color);
+		drawColumnSpan(x0 + r, y0, y0, color);
+		return;
+	}
 	int16_t f = 1 - r;
 	int16_t ddF_x = 1;
 	int16_t ddF_y = -2 * r;
@@ -316,6 +658,12 @@ void NOKIA_5110_graphics::drawCircleHelper(uint16_t x0, uint16_t y0, uint16_t r,
 	@param    color
 */
 void NOKIA_5110_graphics::fillCircle(uint16_t x0, uint16_t y0, uint16_t r, uint8_t color) {
+	if (r <= LCD_CIRCLE_TABLE_MAX)
+	{
+		drawColumnSpan(x0, y0 - r, y0 + r, color);
+		drawCircleSpans(x0, x0, y0, y0, r, 3, true, color);
+		return;
+	}
 	drawVLine(x0, y0-r, 2*r+1, color);
 	fillCircleHelper(x0, y0, r, 3, 0, color);
 }
@@ -397,6 +745,12 @@ void NOKIA_5110_graphics::drawRoundRect(uint16_t x, uint16_t y, uint16_t w, uint
 	drawVLine(x    , y+r  , h-2*r, color); // Left
 	drawVLine(x+w-1, y+r  , h-2*r, color); // Right
 
+	// a radius of 1 plots its corners on the centre row and column , so stays a pixel at a time
+	if (r > 1 && r <= LCD_CIRCLE_TABLE_MAX)
+	{
+		drawCircleSpans(x + r, x + w - r - 1, y + r, y + h - r - 1, r, 0x0F, false, color);
+		return;
+	}
 	drawCircleHelper(x+r    , y+r    , r, 1, color);
 	drawCircleHelper(x+w-r-1, y+r    , r, 2, color);
 	drawCircleHelper(x+w-r-1, y+h-r-1, r, 4, color);
@@ -420,11 +774,122 @@ void NOKIA_5110_graphics::fillRoundRect(uint16_t x, uint16_t y, uint16_t w,
 
 	fillRect(x+r, y, w-2*r, h, color);
 
+	if (r <= LCD_CIRCLE_TABLE_MAX)
+	{
+		drawCircleSpans(x + r, x + w - r - 1, y + r, y + h - r - 1, r, 3, true, color);
+		return;
+	}
 	fillCircleHelper(x+w-r-1, y+r, r, 1, h-2*r-1, color);
 	fillCircleHelper(x+r    , y+r, r, 2, h-2*r-1, color);
 }
 
 
+/*!
+	@brief Find the lowest and highest sample of each column of a plot
+	@param samples The samples
+	@param count Number of samples
+	@param w Number of columns in the plot
+	@param first First column to do
+	@param last One past the last column to do
+	@param low Returns the lowest sample of each column
+	@param high Returns the highest sample of each column
+	@details Column c holds samples c*count/w up to (c+1)*count/w, at least one , and the
+		last sample of the column before so neighbouring columns join. The inner loop keeps
+		four lanes with no branches , the compiler can map them to one SIMD min and max.
+		NaN samples are ignored.
+*/
+static void plotColumns(const float *samples, size_t count, uint8_t w, uint8_t first, uint8_t last,
+	float *low, float *high)
+{
+	for (uint8_t c = first; c < last; c++)
+	{
+		size_t start = c * count / w;
+		size_t end = (c + 1) * count / w;
+		if (end <= start) end = start + 1;
+		if (start > 0) start--;
+		// four independent lanes , no loop carried dependency between them
+		float lo[4] = {INFINITY, INFINITY, INFINITY, INFINITY};
+		float hi[4] = {-INFINITY, -INFINITY, -INFINITY, -INFINITY};
+		size_t i = start;
+		for (; i + 4 <= end; i += 4)
+		{
+			for (uint8_t k = 0; k < 4; k++)
+			{
+				float value = samples[i + k];
+				lo[k] = (value < lo[k]) ? value : lo[k];
+				hi[k] = (value > hi[k]) ? value : hi[k];
+			}
+		}
+		for (; i < end; i++)
+		{
+			lo[0] = (samples[i] < lo[0]) ? samples[i] : lo[0];
+			hi[0] = (samples[i] > hi[0]) ? samples[i] : hi[0];
+		}
+		lo[0] = (lo[1] < lo[0]) ? lo[1] : lo[0];
+		lo[2] = (lo[3] < lo[2]) ? lo[3] : lo[2];
+		hi[0] = (hi[1] > hi[0]) ? hi[1] : hi[0];
+		hi[2] = (hi[3] > hi[2]) ? hi[3] : hi[2];
+		low[c] = (lo[2] < lo[0]) ? lo[2] : lo[0];
+		high[c] = (hi[2] > hi[0]) ? hi[2] : hi[0];
+	}
+}
+
+/*!
+	@brief Draw a line plot of many samples , decimated to one vertical span per column
+	@param box Box the plot fills , the samples are spread across its width
+	@param samples The samples , oldest on the left
+	@param count Number of samples
+	@param minValue Value at bottom of box
+	@param maxValue Value at top of box
+	@param color color of plot
+	@param threads Threads to find the column spans with , used from LCD_PLOT_THREAD_MIN samples
+	@return LCD_Return_Codes_e
+	@details The lowest and highest sample of each column is found in one pass over the
+		samples, then each column is drawn as one drawVLine from low to high. The work grows
+		with the number of samples, not the pixels drawn. Values outside the range are
+		clamped to the box. The box is not cleared first.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::drawPlot(const LCD_Rect_t &box, const float *samples, size_t count,
+	float minValue, float maxValue, uint8_t color, uint8_t threads)
+{
+	if (samples == nullptr)
+		return reportError(LCD_BitmapNullptr, "Error drawPlot 1: Samples is not valid pointer");
+	if (box.x < 0 || box.y < 0 || box.w == 0 || box.h == 0 || box.x + box.w > 256 || box.y + box.h > 256)
+		return reportError(LCD_BitmapScreenBounds, "Error drawPlot 2: Box out of bounds, check x y w and h");
+	if (count == 0)
+		return LCD_Success;
+
+	const uint8_t w = box.w;
+	float low[256], high[256];
+	if (threads > 1 && count >= LCD_PLOT_THREAD_MIN)
+	{
+		if (threads > w) threads = w;
+		std::vector<std::thread> workers;
+		for (uint8_t t = 1; t < threads; t++)
+			workers.emplace_back(plotColumns, samples, count, w, t * w / threads, (t + 1) * w / threads, low, high);
+		plotColumns(samples, count, w, 0, w / threads, low, high);
+		for (std::thread &worker : workers)
+			worker.join();
+	} else {
+		plotColumns(samples, count, w, 0, w, low, high);
+	}
+
+	const float scale = (maxValue > minValue) ? (box.h - 1) / (maxValue - minValue) : 0;
+	for (uint8_t c = 0; c < w; c++)
+	{
+		if (low[c] > high[c])
+			continue; // only NaN in column
+		float top = (high[c] - minValue) * scale;
+		float bottom = (low[c] - minValue) * scale;
+		top = (top > box.h - 1) ? box.h - 1 : ((top < 0) ? 0 : top);
+		bottom = (bottom > box.h - 1) ? box.h - 1 : ((bottom < 0) ? 0 : bottom);
+		uint8_t yTop = box.y + box.h - 1 - (uint8_t)(top + 0.5f);
+		uint8_t yBottom = box.y + box.h - 1 - (uint8_t)(bottom + 0.5f);
+		drawVLine(box.x + c, yTop, yBottom - yTop + 1, color);
+	}
+	return LCD_Success;
+}
+
 /*!
 	@brief  Draw a triangle with no fill color
 	@param    x0  Vertex #0 x coordinate
@@ -442,6 +907,55 @@ void NOKIA_5110_graphics::drawTriangle(uint16_t x0, uint16_t y0, uint16_t x1, ui
 	drawLine_2(x2, y2, x0, y0, color);
 }
 
+/*! Steps along a polygon edge a scanline at a time. At step k the edge is at
+	x0 + k*dx/dy , rounded toward zero as integer division rounds, kept as a whole
+	part and a remainder so each step is an add and a compare , no division. */
+struct EdgeStepper_t
+{
+	int16_t x0;      /**< x at step 0 */
+	int8_t sign;     /**< Direction of dx */
+	int32_t offset;  /**< |x - x0| at this step */
+	int32_t error;   /**< Remainder of offset , 0 to dy-1 */
+	int32_t whole;   /**< |dx| / dy */
+	int32_t part;    /**< |dx| % dy */
+	int32_t dy;      /**< Scanlines the edge spans , more than 0 */
+
+	/*!
+		@brief Set up an edge at a step
+		@param startX x at step 0
+		@param dx x change over the edge
+		@param height y change over the edge , more than 0
+		@param k Step to start at
+	*/
+	void start(int16_t startX, int32_t dx, int32_t height, int32_t k)
+	{
+		x0 = startX;
+		sign = (dx < 0) ? -1 : 1;
+		dy = height;
+		int32_t absDx = (dx < 0) ? -dx : dx;
+		whole = absDx / dy;
+		part = absDx % dy;
+		// k and |dx| can each near 65535 for far off screen vertices , int64 holds the product
+		int64_t run = (int64_t)k * absDx;
+		offset = (int32_t)(run / dy);
+		error = (int32_t)(run % dy);
+	}
+
+	/*! @return x at this step , then move to the next */
+	int16_t next()
+	{
+		int16_t x = x0 + sign * offset;
+		offset += whole;
+		error += part;
+		if (error >= dy)
+		{
+			offset++;
+			error -= dy;
+		}
+		return x;
+	}
+};
+
 /*!
 	@brief    Draw a triangle with color-fill
 	@param    x0  Vertex #0 x coordinate
@@ -455,9 +969,6 @@ void NOKIA_5110_graphics::drawTriangle(uint16_t x0, uint16_t y0, uint16_t x1, ui
 void NOKIA_5110_graphics::fillTriangle(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
 	uint16_t x2, uint16_t y2, uint8_t color) {
 	int16_t a, b, y, last, dx01, dy01, dx02, dy02, dx12, dy12;
-	int32_t
-	sa   = 0,
-	sb   = 0;
 
 	if (y0 > y1) {
 		LCD_swap_int16_t(y0, y1); LCD_swap_int16_t(x0, x1);
@@ -489,106 +1000,1227 @@ void NOKIA_5110_graphics::fillTriangle(uint16_t x0, uint16_t y0, uint16_t x1, ui
 	if(y1 == y2) last = y1;
 	else         last = y1-1;
 
+	// the edges are stepped with the same rounding as x0 + k*dx/dy
+	EdgeStepper_t edgeA = {}, edgeB = {};
+	edgeB.start(x0, dx02, dy02, 0);
+	if (dy01 > 0) edgeA.start(x0, dx01, dy01, 0);
 	for(y=y0; y<=last; y++) {
-		a   = x0 + sa / dy01;
-		b   = x0 + sb / dy02;
-		sa += dx01;
-		sb += dx02;
+		a   = edgeA.next();
+		b   = edgeB.next();
 
 		if(a > b) LCD_swap_int16_t(a,b);
 		drawHLine(a, y, b-a+1, color);
 	}
 
-	sa = dx12 * (y - y1);
-	sb = dx02 * (y - y0);
+	if (y > y2)
+		return;
+	edgeA.start(x1, dx12, dy12, y - y1);
 	for(; y<=y2; y++) {
-		a   = x1 + sa / dy12;
-		b   = x0 + sb / dy02;
-		sa += dx12;
-		sb += dx02;
+		a   = edgeA.next();
+		b   = edgeB.next();
 
 		if(a > b) LCD_swap_int16_t(a,b);
 		drawHLine(a, y, b-a+1, color);
 	}
 }
 
+/*!
+	@brief Draw a line in signed co-ordinates , clipped to the screen
+	@param x0 x co-ord of start
+	@param y0 y co-ord of start
+	@param x1 x co-ord of end
+	@param y1 y co-ord of end
+	@param color color of line
+	@note Bresenham line drawn as a vertical span per column with drawColumnSpan ,
+		so the banks are written directly when not rotated.
+*/
+void NOKIA_5110_graphics::drawLineSpans(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint8_t color)
+{
+	const int32_t dx = abs(x1 - x0), dy = -abs(y1 - y0);
+	const int32_t sx = (x0 < x1) ? 1 : -1, sy = (y0 < y1) ? 1 : -1;
+	int32_t error = dx + dy;
+	int32_t runStart = y0;
+	while (x0 != x1 || y0 != y1)
+	{
+		int32_t error2 = 2 * error;
+		if (error2 >= dy)
+		{
+			// x moves on , so the pixels of this column are one span
+			drawColumnSpan(x0, (runStart < y0) ? runStart : y0, (runStart < y0) ? y0 : runStart, color);
+			error += dy;
+			x0 += sx;
+			if (error2 <= dx)
+			{
+				error += dx;
+				y0 += sy;
+			}
+			runStart = y0;
+			continue;
+		}
+		error += dx;
+		y0 += sy;
+	}
+	drawColumnSpan(x0, (runStart < y0) ? runStart : y0, (runStart < y0) ? y0 : runStart, color);
+}
 
 /*!
-	@brief print custom char  (dimension: 5x8 x by y pixels)
-	@param character the character to draw
-	@param sizeofArray The size of the character array passed must be 5
+	@brief Draw the outline of a polygon , the last point joins back to the first
+	@param points The vertices , screen co-ordinates , may lie off screen
+	@param count Number of vertices , up to LCD_POLYGON_MAX_POINTS
+	@param color color to draw
 	@return LCD_Return_Codes_e
 */
-LCD_Return_Codes_e NOKIA_5110_graphics::customChar(const uint8_t* character, uint16_t sizeofArray) {
-
-	// Check for null pointer
-	if(character == nullptr)
+LCD_Return_Codes_e NOKIA_5110_graphics::drawPolygon(const LCD_Point_t *points, size_t count, uint8_t color)
+{
+	if (count == 0)
+		return LCD_Success;
+	if (points == nullptr)
+		return reportError(LCD_BitmapNullptr, "Error drawPolygon 1: Points is not valid pointer");
+	if (count > LCD_POLYGON_MAX_POINTS)
+		return reportError(LCD_BitmapSize, "Error drawPolygon 2: More than LCD_POLYGON_MAX_POINTS points");
+
+	for (size_t i = 0; i < count; i++)
 	{
-		std::cout<< "Error customChar 1 :Custom char array is not valid pointer" << std::endl;
-		return LCD_BitmapNullptr;
+		const LCD_Point_t &to = points[(i + 1) % count];
+		drawLineSpans(points[i].x, points[i].y, to.x, to.y, color);
 	}
+	return LCD_Success;
+}
 
-	const uint8_t CustomCharWidth = 5;
-	const uint8_t CustomCharHeight = 8;
-	uint8_t i = 0;
-	uint8_t j = 0;
-
-	// check Array is correct size '5'
-	if(sizeofArray != CustomCharWidth )
+/*!
+	@brief Draw a polygon with color-fill , convex or concave , the last point joins back to the first
+	@param points The vertices , screen co-ordinates , may lie off screen
+	@param count Number of vertices , up to LCD_POLYGON_MAX_POINTS
+	@param color color to fill
+	@return LCD_Return_Codes_e
+	@details Scanline fill with an active edge table and the even-odd rule. The edges are
+		sorted by top row, each scanline adds the edges that start there and drops those that
+		end, and each edge is stepped with an add and a compare, no division. The spans
+		between pairs of crossings are clipped to the screen. Not rotated they are gathered
+		into a byte mask per column for each bank and written a bank at a time, rotated they
+		are drawn with drawHLine. The outline is drawn last so the bottom rows and the
+		horizontal edges are covered as fillTriangle covers them.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::fillPolygon(const LCD_Point_t *points, size_t count, uint8_t color)
+{
+	if (count == 0)
+		return LCD_Success;
+	if (points == nullptr)
+		return reportError(LCD_BitmapNullptr, "Error fillPolygon 1: Points is not valid pointer");
+	if (count > LCD_POLYGON_MAX_POINTS)
+		return reportError(LCD_BitmapSize, "Error fillPolygon 2: More than LCD_POLYGON_MAX_POINTS points");
+
+	// Edge table , each edge from its top vertex , covering rows top to bottom - 1
+	struct PolygonEdge_t
+	{
+		int16_t top;
+		int16_t bottom;
+		int16_t x;
+		int16_t dx;
+		EdgeStepper_t stepper;
+	};
+	PolygonEdge_t edges[LCD_POLYGON_MAX_POINTS];
+	uint8_t edgeCount = 0;
+	int16_t minY = INT16_MAX, maxY = INT16_MIN;
+	for (size_t i = 0; i < count; i++)
 	{
-		std::cout << "Error customChar 2 :: CustomChar array must always be 5 bytes long :" << sizeofArray<<std::endl;
-		return LCD_CustomCharLen;
+		const LCD_Point_t *from = &points[i];
+		const LCD_Point_t *to = &points[(i + 1) % count];
+		if (from->y == to->y)
+			continue;
+		if (from->y > to->y)
+			std::swap(from, to);
+		// insertion sort by top row
+		uint8_t slot = edgeCount++;
+		while (slot > 0 && edges[slot - 1].top > from->y)
+		{
+			edges[slot] = edges[slot - 1];
+			slot--;
+		}
+		edges[slot] = {from->y, to->y, from->x, static_cast<int16_t>(to->x - from->x), {}};
+		if (from->y < minY) minY = from->y;
+		if (to->y > maxY) maxY = to->y;
 	}
 
-	for(i = 0; i < CustomCharWidth ; i++ )
+	const int16_t firstRow = (minY < 0) ? 0 : minY;
+	const int16_t lastRow = (maxY >= _height) ? _height - 1 : maxY;
+	uint8_t active[LCD_POLYGON_MAX_POINTS];
+	uint8_t activeCount = 0;
+	uint8_t nextEdge = 0;
+
+	// Not rotated , the spans of the eight rows of a bank are gathered as a mask per
+	// column and each byte of the bank is written once
+	const bool direct = (_buffer != nullptr && _LCD_rotate == LCD_Degrees_0);
+	uint8_t masks[256] = {0};
+	int16_t maskBank = -1, maskLeft = 0, maskRight = -1;
+	auto flushBank = [&]()
 	{
-		uint8_t line = character[i];
-		for(j = 0; j < CustomCharHeight ; j++, line >>= 1)
+		uint8_t *pByte = &_buffer[maskBank * _bufferWidth];
+		for (int16_t x = maskLeft; x <= maskRight; x++)
 		{
-			if(line & 1)
-			{
-			if(_textSize == 1)
-				LCDDrawPixel(_cursorX + i, _cursorY + j, _textColor);
-			else
-				fillRect(_cursorX + i * _textSize, _cursorY + j * _textSize, _textSize, _textSize, _textColor);
-			}
-			else
-			if(_textBgColor != _textColor)
+			uint8_t value = color ? (pByte[x] | masks[x]) : (pByte[x] & ~masks[x]);
+			masks[x] = 0;
+			if (value != pByte[x])
 			{
-				if(_textSize == 1)
-					LCDDrawPixel(_cursorX + i, _cursorY + j, _textBgColor);
-				else
-					fillRect(_cursorX + i * _textSize, _cursorY + j * _textSize, _textSize, _textSize, _textBgColor);
+				pByte[x] = value;
+				markDirtyByte(x, maskBank);
 			}
 		}
-	}
+		maskLeft = _width;
+		maskRight = -1;
+	};
 
-	if(_textBgColor != _textColor)
+	for (int16_t y = firstRow; y <= lastRow; y++)
 	{
-		if(_textSize == 1)
-			drawVLine(_cursorX + CustomCharWidth , _cursorY, CustomCharHeight , _textBgColor);
-		else
-			fillRect(_cursorX + CustomCharWidth  * _textSize, _cursorY, _textSize, CustomCharHeight  * _textSize, _textBgColor);
-	}
-
-	_cursorX += _textSize * (CustomCharWidth+1) ;
-
-	if( _cursorX > ((uint16_t)_width + _textSize * (CustomCharWidth +1)) )
-		_cursorX = _width;
+		// drop the edges that have ended, add those that start here
+		uint8_t kept = 0;
+		for (uint8_t i = 0; i < activeCount; i++)
+			if (edges[active[i]].bottom > y)
+				active[kept++] = active[i];
+		activeCount = kept;
+		for (; nextEdge < edgeCount && edges[nextEdge].top <= y; nextEdge++)
+		{
+			PolygonEdge_t &edge = edges[nextEdge];
+			if (edge.bottom <= y)
+				continue;
+			edge.stepper.start(edge.x, edge.dx, edge.bottom - edge.top, y - edge.top);
+			active[activeCount++] = nextEdge;
+		}
 
-	if (_textWrap && (_cursorX + (_textSize * CustomCharWidth )) > _width)
-	{
-		_cursorX = 0;
-		_cursorY += _textSize * CustomCharHeight ;
-		if( _cursorY > ((uint16_t)_height + _textSize * CustomCharHeight ) )
-			_cursorY = _height;
+		// crossings in x order , then fill between each pair
+		int16_t crossings[LCD_POLYGON_MAX_POINTS];
+		for (uint8_t i = 0; i < activeCount; i++)
+		{
+			int16_t x = edges[active[i]].stepper.next();
+			uint8_t slot = i;
+			while (slot > 0 && crossings[slot - 1] > x)
+			{
+				crossings[slot] = crossings[slot - 1];
+				slot--;
+			}
+			crossings[slot] = x;
+		}
+		for (uint8_t i = 0; i + 1 < activeCount; i += 2)
+		{
+			int16_t left = (crossings[i] < 0) ? 0 : crossings[i];
+			int16_t right = (crossings[i + 1] >= _width) ? _width - 1 : crossings[i + 1];
+			if (left > right)
+				continue;
+			if (!direct)
+			{
+				drawHLine(left, y, right - left + 1, color);
+				continue;
+			}
+			if ((y >> 3) != maskBank)
+			{
+				if (maskRight >= 0) flushBank();
+				maskBank = y >> 3;
+				maskLeft = _width;
+			}
+			const uint8_t bit = 1 << (y & 7);
+			for (int16_t x = left; x <= right; x++)
+				masks[x] |= bit;
+			if (left < maskLeft) maskLeft = left;
+			if (right > maskRight) maskRight = right;
+		}
 	}
-	return LCD_Success;
-}
+	if (maskRight >= 0)
+		flushBank();
 
+	return drawPolygon(points, count, color);
+}
 
 /*!
-	@brief  Draw a single character font 1-6
+	@brief Walk the columns of an ellipse outline , a quarter of it
+	@param a x radius
+	@param b y radius
+	@param emit Called for each column offset dx from a down to 0 with the row offsets
+		low to high of the outline in that column
+	@note Midpoint ellipse with an integer error term , after A. Zingl, "A Rasterizing
+		Algorithm for Drawing Curves". Each step moves x, y or both , so the pixels of a
+		column are one run.
+*/
+template <typename EmitColumn>
+static void ellipseColumns(int32_t a, int32_t b, EmitColumn emit)
+{
+	int32_t x = -a, y = 0;
+	const int64_t aa = static_cast<int64_t>(a) * a, bb = static_cast<int64_t>(b) * b;
+	int64_t error = x * (2 * bb + x) + bb;
+	int32_t column = x, low = 0, high = 0;
+	do {
+		if (x != column)
+		{
+			emit(-column, low, high);
+			column = x;
+			low = y;
+		}
+		high = y;
+		int64_t error2 = 2 * error;
+		if (error2 >= (x * 2 + 1) * bb)
+		{
+			x++;
+			error += (x * 2 + 1) * bb;
+		}
+		if (error2 <= (y * 2 + 1) * aa)
+		{
+			y++;
+			error += (y * 2 + 1) * aa;
+		}
+	} while (x <= 0);
+	// flat ellipses stop early , finish the tip
+	emit(0, low, (high < b) ? b : high);
+}
+
+/*!
+	@brief Draw an ellipse with no fill
+	@param x0 Center-point x coordinate
+	@param y0 Center-point y coordinate
+	@param rx x radius
+	@param ry y radius
+	@param color color of ellipse
+	@note Drawn a column at a time, the upper and lower outline runs of each column
+		are spans written straight to the banks when not rotated.
+*/
+void NOKIA_5110_graphics::drawEllipse(uint16_t x0, uint16_t y0, uint16_t rx, uint16_t ry, uint8_t color)
+{
+	ellipseColumns(rx, ry, [&](int32_t dx, int32_t low, int32_t high)
+	{
+		for (int32_t x : {x0 - dx, x0 + dx})
+		{
+			if (low == 0)
+				drawColumnSpan(x, y0 - high, y0 + high, color);
+			else
+			{
+				drawColumnSpan(x, y0 - high, y0 - low, color);
+				drawColumnSpan(x, y0 + low, y0 + high, color);
+			}
+			if (dx == 0)
+				break;
+		}
+	});
+}
+
+/*!
+	@brief Draw an ellipse with color-fill
+	@param x0 Center-point x coordinate
+	@param y0 Center-point y coordinate
+	@param rx x radius
+	@param ry y radius
+	@param color color of ellipse
+	@note Each column is one span, written straight to the banks when not rotated.
+*/
+void NOKIA_5110_graphics::fillEllipse(uint16_t x0, uint16_t y0, uint16_t rx, uint16_t ry, uint8_t color)
+{
+	ellipseColumns(rx, ry, [&](int32_t dx, int32_t, int32_t high)
+	{
+		drawColumnSpan(x0 - dx, y0 - high, y0 + high, color);
+		if (dx != 0)
+			drawColumnSpan(x0 + dx, y0 - high, y0 + high, color);
+	});
+}
+
+/*! Rows of a column that lie on the clockwise side of a ray from the centre ,
+	a.x*y - a.y*x >= 0 , as first to last , empty when first > last. */
+static void halfPlaneRows(int32_t ax, int32_t ay, int32_t x, int32_t &first, int32_t &last)
+{
+	const int32_t none = INT16_MAX;
+	const int32_t product = ay * x;
+	first = -none;
+	last = none;
+	if (ax > 0) // y >= ceil(product / ax)
+		first = (product >= 0) ? (product + ax - 1) / ax : -((-product) / ax);
+	else if (ax < 0) // y <= floor(product / ax)
+		last = (product <= 0) ? (-product) / (-ax) : -((product - ax - 1) / (-ax));
+	else if (product > 0)
+	{
+		first = none;
+		last = -none;
+	}
+}
+
+/*!
+	@brief Draw a ring of a circle , whole or between two angles
+	@param x0 Center-point x coordinate
+	@param y0 Center-point y coordinate
+	@param r Outer radius
+	@param innerR Inner radius , the pixels of the inner outline are part of the ring
+	@param startAngle Start of the arc in degrees , clockwise from 12 o'clock
+	@param endAngle End of the arc in degrees , clockwise from 12 o'clock
+	@param color color of ring
+	@note The outer and inner outlines come from the midpoint ellipse column walk. In each
+		column the ring is two runs of rows, the angle limits are the rows on the right side of
+		the start and end rays, worked out per column, so each run is one or two spans.
+*/
+void NOKIA_5110_graphics::drawArcSpans(int32_t x0, int32_t y0, uint8_t r, uint8_t innerR,
+	int16_t startAngle, int16_t endAngle, uint8_t color)
+{
+	// Rays as integer vectors , screen y is down
+	const float toRadians = 3.14159265f / 180.0f;
+	const int32_t sx = lroundf(1024 * sinf(startAngle * toRadians));
+	const int32_t sy = lroundf(-1024 * cosf(startAngle * toRadians));
+	const int32_t ex = lroundf(1024 * sinf(endAngle * toRadians));
+	const int32_t ey = lroundf(-1024 * cosf(endAngle * toRadians));
+	const int32_t sweep = endAngle - startAngle;
+	const bool whole = (sweep >= 360 || sweep <= -360);
+	const bool wide = (((sweep % 360) + 360) % 360) > 180;
+	if (sweep == 0)
+		return; // the half planes would meet along the whole diameter
+
+	// The inner outline , nearest row to the centre in each column
+	uint8_t innerLow[256];
+	ellipseColumns(innerR, innerR, [&](int32_t dx, int32_t low, int32_t)
+	{
+		innerLow[dx] = low;
+	});
+
+	auto drawRun = [&](int32_t dx, int32_t first, int32_t last)
+	{
+		if (whole)
+		{
+			drawColumnSpan(x0 + dx, y0 + first, y0 + last, color);
+			return;
+		}
+		// clockwise of the start ray , anticlockwise of the end ray
+		int32_t startFirst, startLast, endFirst, endLast;
+		halfPlaneRows(sx, sy, dx, startFirst, startLast);
+		halfPlaneRows(-ex, -ey, dx, endFirst, endLast);
+		if (!wide)
+		{
+			int32_t from = std::max({first, startFirst, endFirst});
+			int32_t to = std::min({last, startLast, endLast});
+			drawColumnSpan(x0 + dx, y0 + from, y0 + to, color);
+			return;
+		}
+		// over half a turn , either side will do , overlapping spans are drawn once
+		if (startFirst <= endLast + 1 && endFirst <= startLast + 1)
+		{
+			startFirst = std::min(startFirst, endFirst);
+			startLast = std::max(startLast, endLast);
+			endFirst = 1;
+			endLast = 0;
+		}
+		drawColumnSpan(x0 + dx, y0 + std::max(first, startFirst), y0 + std::min(last, startLast), color);
+		drawColumnSpan(x0 + dx, y0 + std::max(first, endFirst), y0 + std::min(last, endLast), color);
+	};
+
+	ellipseColumns(r, r, [&](int32_t dx, int32_t low, int32_t high)
+	{
+		low = (dx <= innerR) ? innerLow[dx] : 0;
+		for (int32_t side : {-dx, dx})
+		{
+			if (low == 0)
+				drawRun(side, -high, high);
+			else
+			{
+				drawRun(side, -high, -low);
+				drawRun(side, low, high);
+			}
+			if (dx == 0)
+				break;
+		}
+	});
+}
+
+/*!
+	@brief Draw an arc of a circle
+	@param x0 Center-point x coordinate
+	@param y0 Center-point y coordinate
+	@param r Radius
+	@param startAngle Start of the arc in degrees , clockwise from 12 o'clock
+	@param endAngle End of the arc in degrees , clockwise from 12 o'clock ,
+		a sweep of 360 or more is the whole circle
+	@param color color of arc
+	@note The arc runs clockwise from startAngle to endAngle, equal angles draw nothing.
+*/
+void NOKIA_5110_graphics::drawArc(uint16_t x0, uint16_t y0, uint8_t r, int16_t startAngle, int16_t endAngle, uint8_t color)
+{
+	drawArcSpans(x0, y0, r, r, startAngle, endAngle, color);
+}
+
+/*!
+	@brief Draw a filled arc , a pie slice or with an inner radius a segment of a ring ,
+		e.g. a dial or gauge
+	@param x0 Center-point x coordinate
+	@param y0 Center-point y coordinate
+	@param r Outer radius
+	@param innerR Inner radius , 0 for a pie slice
+	@param startAngle Start of the arc in degrees , clockwise from 12 o'clock
+	@param endAngle End of the arc in degrees , clockwise from 12 o'clock ,
+		a sweep of 360 or more is the whole ring , equal angles draw nothing
+	@param color color of arc
+*/
+void NOKIA_5110_graphics::fillArc(uint16_t x0, uint16_t y0, uint8_t r, uint8_t innerR,
+	int16_t startAngle, int16_t endAngle, uint8_t color)
+{
+	drawArcSpans(x0, y0, r, (innerR > r) ? r : innerR, startAngle, endAngle, color);
+}
+
+/*!
+	@brief Draw a quadratic Bezier curve
+	@param p0 Start point
+	@param p1 Control point
+	@param p2 End point
+	@param color color of curve
+	@note The curve is stepped by forward differencing in 32.32 fixed point , adds only ,
+		a step every few pixels of the control polygon , the points joined by drawLineSpans.
+*/
+void NOKIA_5110_graphics::drawBezier(const LCD_Point_t &p0, const LCD_Point_t &p1, const LCD_Point_t &p2, uint8_t color)
+{
+	const int32_t length = abs(p1.x - p0.x) + abs(p1.y - p0.y) + abs(p2.x - p1.x) + abs(p2.y - p1.y);
+	const int64_t steps = std::min<int32_t>(std::max<int32_t>(length / 3, 1), 256);
+	const int64_t one = INT64_C(1) << 32;
+
+	// P(t) = a*t^2 + b*t + p0 , with t stepped by 1/steps
+	int64_t x = p0.x * one, y = p0.y * one;
+	int64_t ax = p0.x - 2 * p1.x + p2.x, ay = p0.y - 2 * p1.y + p2.y;
+	int64_t bx = 2 * (p1.x - p0.x), by = 2 * (p1.y - p0.y);
+	int64_t dx = (ax * one) / (steps * steps) + (bx * one) / steps;
+	int64_t dy = (ay * one) / (steps * steps) + (by * one) / steps;
+	const int64_t ddx = (2 * ax * one) / (steps * steps), ddy = (2 * ay * one) / (steps * steps);
+
+	int32_t lastX = p0.x, lastY = p0.y;
+	for (int64_t i = 1; i <= steps; i++)
+	{
+		x += dx; y += dy;
+		dx += ddx; dy += ddy;
+		int32_t nextX = (i == steps) ? p2.x : static_cast<int32_t>((x + one / 2) >> 32);
+		int32_t nextY = (i == steps) ? p2.y : static_cast<int32_t>((y + one / 2) >> 32);
+		drawLineSpans(lastX, lastY, nextX, nextY, color);
+		lastX = nextX;
+		lastY = nextY;
+	}
+}
+
+/*!
+	@brief Draw a cubic Bezier curve
+	@param p0 Start point
+	@param p1 First control point
+	@param p2 Second control point
+	@param p3 End point
+	@param color color of curve
+	@note Stepped by forward differencing as the quadratic curve, three differences.
+*/
+void NOKIA_5110_graphics::drawBezier(const LCD_Point_t &p0, const LCD_Point_t &p1, const LCD_Point_t &p2,
+	const LCD_Point_t &p3, uint8_t color)
+{
+	const int32_t length = abs(p1.x - p0.x) + abs(p1.y - p0.y) + abs(p2.x - p1.x) + abs(p2.y - p1.y)
+		+ abs(p3.x - p2.x) + abs(p3.y - p2.y);
+	const int64_t steps = std::min<int32_t>(std::max<int32_t>(length / 3, 1), 256);
+	const int64_t one = INT64_C(1) << 32;
+	const int64_t steps2 = steps * steps, steps3 = steps2 * steps;
+
+	// P(t) = a*t^3 + b*t^2 + c*t + p0 , with t stepped by 1/steps
+	int64_t x = p0.x * one, y = p0.y * one;
+	int64_t ax = -p0.x + 3 * p1.x - 3 * p2.x + p3.x, ay = -p0.y + 3 * p1.y - 3 * p2.y + p3.y;
+	int64_t bx = 3 * p0.x - 6 * p1.x + 3 * p2.x, by = 3 * p0.y - 6 * p1.y + 3 * p2.y;
+	int64_t cx = 3 * (p1.x - p0.x), cy = 3 * (p1.y - p0.y);
+	int64_t dx = (ax * one) / steps3 + (bx * one) / steps2 + (cx * one) / steps;
+	int64_t dy = (ay * one) / steps3 + (by * one) / steps2 + (cy * one) / steps;
+	int64_t ddx = (6 * ax * one) / steps3 + (2 * bx * one) / steps2;
+	int64_t ddy = (6 * ay * one) / steps3 + (2 * by * one) / steps2;
+	const int64_t dddx = (6 * ax * one) / steps3, dddy = (6 * ay * one) / steps3;
+
+	int32_t lastX = p0.x, lastY = p0.y;
+	for (int64_t i = 1; i <= steps; i++)
+	{
+		x += dx; y += dy;
+		dx += ddx; dy += ddy;
+		ddx += dddx; ddy += dddy;
+		int32_t nextX = (i == steps) ? p3.x : static_cast<int32_t>((x + one / 2) >> 32);
+		int32_t nextY = (i == steps) ? p3.y : static_cast<int32_t>((y + one / 2) >> 32);
+		drawLineSpans(lastX, lastY, nextX, nextY, color);
+		lastX = nextX;
+		lastY = nextY;
+	}
+}
+
+
+/*!
+	@brief print custom char  (dimension: 5x8 x by y pixels)
+	@param character the character to draw
+	@param sizeofArray The size of the character array passed must be 5
+	@return LCD_Return_Codes_e
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::customChar(const uint8_t* character, uint16_t sizeofArray) {
+
+	// Check for null pointer
+	if(character == nullptr)
+	{
+		return reportError(LCD_BitmapNullptr, "Error customChar 1: Custom char array is not valid pointer");
+	}
+
+	const uint8_t CustomCharWidth = 5;
+	const uint8_t CustomCharHeight = 8;
+	uint8_t i = 0;
+	uint8_t j = 0;
+
+	// check Array is correct size '5'
+	if(sizeofArray != CustomCharWidth )
+	{
+		return reportError(LCD_CustomCharLen, "Error customChar 2: CustomChar array must always be 5 bytes long");
+	}
+
+	for(i = 0; i < CustomCharWidth ; i++ )
+	{
+		uint8_t line = character[i];
+		for(j = 0; j < CustomCharHeight ; j++, line >>= 1)
+		{
+			if(line & 1)
+			{
+			if(_textSize == 1)
+				LCDDrawPixel(_cursorX + i, _cursorY + j, _textColor);
+			else
+				fillRect(_cursorX + i * _textSize, _cursorY + j * _textSize, _textSize, _textSize, _textColor);
+			}
+			else
+			if(_textBgColor != _textColor)
+			{
+				if(_textSize == 1)
+					LCDDrawPixel(_cursorX + i, _cursorY + j, _textBgColor);
+				else
+					fillRect(_cursorX + i * _textSize, _cursorY + j * _textSize, _textSize, _textSize, _textBgColor);
+			}
+		}
+	}
+
+	if(_textBgColor != _textColor)
+	{
+		if(_textSize == 1)
+			drawVLine(_cursorX + CustomCharWidth , _cursorY, CustomCharHeight , _textBgColor);
+		else
+			fillRect(_cursorX + CustomCharWidth  * _textSize, _cursorY, _textSize, CustomCharHeight  * _textSize, _textBgColor);
+	}
+
+	_cursorX += _textSize * (CustomCharWidth+1) ;
+
+	if( _cursorX > ((uint16_t)_width + _textSize * (CustomCharWidth +1)) )
+		_cursorX = _width;
+
+	if (_textWrap && (_cursorX + (_textSize * CustomCharWidth )) > _width)
+	{
+		_cursorX = 0;
+		_cursorY += _textSize * CustomCharHeight ;
+		if( _cursorY > ((uint16_t)_height + _textSize * CustomCharHeight ) )
+			_cursorY = _height;
+	}
+	return LCD_Success;
+}
+
+
+/*!
+	@brief Write up to 8 vertical pixels into the bank buffer, byte at a time
+	@param x x co-ord in buffer
+	@param y y co-ord of the first(LSB) pixel in buffer , need not be bank aligned
+	@param bits pixel data , LSB at top
+	@param mask only rows with a bit set in mask are touched
+	@param color color of set bits
+	@param bg color of clear bits, if bg equals color clear bits are transparent
+	@note An unaligned y is shift merged into two banks. Pixels outside the buffer are clipped.
+		Works in unrotated buffer co-ordinates.
+*/
+void NOKIA_5110_graphics::bankWrite(int16_t x, int16_t y, uint8_t bits, uint8_t mask, uint8_t color, uint8_t bg)
+{
+	if (_buffer == nullptr || x < 0 || x >= _bufferWidth || y <= -8 || y >= _bufferHeight)
+		return;
+
+	uint8_t on;
+	uint8_t off;
+	if (bg == color)
+	{
+		on  = color ? (bits & mask) : 0;
+		off = color ? 0 : (bits & mask);
+	} else {
+		on  = ((color ? bits : 0) | (bg ? ~bits : 0)) & mask;
+		off = mask & ~on;
+	}
+
+	if (y < 0)
+	{
+		on  >>= -y;
+		off >>= -y;
+		uint8_t value = (_buffer[x] & ~off) | on;
+		if (value != _buffer[x])
+		{
+			_buffer[x] = value;
+			markDirtyByte(x, 0);
+		}
+		return;
+	}
+
+	uint8_t bank = y >> 3;
+	uint8_t shift = y & 7;
+	uint8_t *pByte = &_buffer[bank * _bufferWidth + x];
+	uint8_t value = (*pByte & ~(uint8_t)(off << shift)) | (uint8_t)(on << shift);
+	if (value != *pByte)
+	{
+		*pByte = value;
+		markDirtyByte(x, bank);
+	}
+	if (shift && (bank + 1) * 8 < _bufferHeight)
+	{
+		pByte += _bufferWidth;
+		value = (*pByte & ~(uint8_t)(off >> (8 - shift))) | (uint8_t)(on >> (8 - shift));
+		if (value != *pByte)
+		{
+			*pByte = value;
+			markDirtyByte(x, bank + 1);
+		}
+	}
+}
+
+/*!
+	@brief Mark a rectangle of the buffer as changed, for LCDdisplayUpdateDirty
+	@param x x co-ord in buffer
+	@param y y co-ord in buffer
+	@param w width in pixels
+	@param h height in pixels
+	@note Drawing methods mark what they change , call this after writing
+		to the buffer directly. Works in unrotated buffer co-ordinates.
+*/
+void NOKIA_5110_graphics::markDirty(uint8_t x, uint8_t y, uint8_t w, uint8_t h)
+{
+	if (w == 0 || h == 0 || x >= _bufferWidth || y >= _bufferHeight)
+		return;
+	uint8_t x1 = (x + w > _bufferWidth) ? _bufferWidth - 1 : x + w - 1;
+	uint8_t y1 = (y + h > _bufferHeight) ? _bufferHeight - 1 : y + h - 1;
+	for (uint8_t bank = y >> 3; bank <= (y1 >> 3); bank++)
+	{
+		markDirtyByte(x, bank);
+		markDirtyByte(x1, bank);
+	}
+}
+
+/*!
+	@brief Move a bank aligned region of the buffer up by whole banks
+	@param x x co-ord of region in buffer
+	@param bank First bank of region
+	@param w Width of region in pixels
+	@param banks Height of region in banks
+	@param count Number of banks to move up by , less than banks
+	@return false if there is no buffer or the region is outside it , nothing is moved
+	@note The bottom count banks of the region are left as they were. Works in unrotated
+		buffer co-ordinates, a column byte is moved at a time and the region marked dirty.
+*/
+bool NOKIA_5110_graphics::scrollBanks(uint8_t x, uint8_t bank, uint8_t w, uint8_t banks, uint8_t count)
+{
+	if (_buffer == nullptr || w == 0 || count == 0 || count >= banks ||
+		x + w > _bufferWidth || (bank + banks) * 8 > _bufferHeight)
+		return false;
+	for (uint8_t k = bank; k < bank + banks - count; k++)
+		memmove(&_buffer[k * _bufferWidth + x], &_buffer[(k + count) * _bufferWidth + x], w);
+	markDirty(x, bank * 8, w, (banks - count) * 8);
+	return true;
+}
+
+/*!
+	@brief Copy bank format data into a bank aligned region of the buffer
+	@param data Source , banks of column bytes LSB at top
+	@param stride Bytes from one source bank to the next , at least w
+	@param x x co-ord of region in buffer
+	@param bank First bank of region
+	@param w Width of region in pixels
+	@param banks Height of region in banks
+	@param lastMask Rows of the last bank to copy , the others are left as they are
+	@return LCD_Return_Codes_e
+	@note One memcpy per whole bank, only the span of bytes that differ is marked dirty.
+		Works in unrotated buffer co-ordinates.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::copyBanks(const uint8_t *data, uint16_t stride, uint8_t x, uint8_t bank, uint8_t w, uint8_t banks, uint8_t lastMask)
+{
+	if (data == nullptr || _buffer == nullptr)
+		return reportError(LCD_BitmapNullptr, "Error copyBanks 1: Data is not valid pointer");
+	if (stride < w || x + w > _bufferWidth || (bank + banks) * 8 > _bufferHeight)
+		return reportError(LCD_BitmapScreenBounds, "Error copyBanks 2: Region out of bounds, check x bank w and banks");
+	for (uint8_t k = 0; k < banks; k++)
+	{
+		const uint8_t *pSrc = data + k * stride;
+		uint8_t *pDest = &_buffer[(bank + k) * _bufferWidth + x];
+		if (k == banks - 1 && lastMask != 0xFF)
+		{
+			// partial bank , merge the masked rows a byte at a time
+			for (uint8_t i = 0; i < w; i++)
+			{
+				uint8_t value = (pDest[i] & ~lastMask) | (pSrc[i] & lastMask);
+				if (value == pDest[i])
+					continue;
+				pDest[i] = value;
+				markDirtyByte(x + i, bank + k);
+			}
+			continue;
+		}
+		uint8_t first = 0, last = w;
+		while (first < w && pSrc[first] == pDest[first]) first++;
+		if (first == w)
+			continue;
+		while (pSrc[last - 1] == pDest[last - 1]) last--;
+		memcpy(pDest + first, pSrc + first, last - first);
+		markDirtyByte(x + first, bank + k);
+		markDirtyByte(x + last - 1, bank + k);
+	}
+	return LCD_Success;
+}
+
+/*!
+	@brief Mark the whole buffer as changed
+*/
+void NOKIA_5110_graphics::markAllDirty()
+{
+	markDirty(0, 0, _bufferWidth, _bufferHeight);
+}
+
+/*!
+	@brief Mark the whole buffer as unchanged, called once changes are sent to the LCD
+*/
+void NOKIA_5110_graphics::clearDirty()
+{
+	memset(_dirtyMin, 0xFF, sizeof(_dirtyMin));
+	memset(_dirtyMax, 0x00, sizeof(_dirtyMax));
+}
+
+/*!
+	@brief Check if any of the buffer has changed since last sent to the LCD
+	@return true if some of the buffer is dirty
+*/
+bool NOKIA_5110_graphics::isDirty()
+{
+	for (uint8_t bank = 0; bank < LCD_MAX_BANKS; bank++)
+		if (_dirtyMin[bank] <= _dirtyMax[bank]) return true;
+	return false;
+}
+
+/*!
+	@brief Get the changed columns of a bank
+	@param bank bank (8 pixel row) of the buffer
+	@param x0 Returns the leftmost changed column
+	@param x1 Returns the rightmost changed column
+	@return false if the bank is clean , x0 and x1 are then not set
+*/
+bool NOKIA_5110_graphics::getDirtySpan(uint8_t bank, uint8_t &x0, uint8_t &x1)
+{
+	if (bank >= LCD_MAX_BANKS || _dirtyMin[bank] > _dirtyMax[bank])
+		return false;
+	x0 = _dirtyMin[bank];
+	x1 = _dirtyMax[bank];
+	return true;
+}
+
+/*!
+	@brief Draw a bank format sprite into the buffer, unset bits are transparent
+	@param sprite The sprite to draw
+	@param x x co-ord of top left corner , may be partly off screen
+	@param y y co-ord of top left corner , may be partly off screen
+	@param color color of sprite black or white
+	@return LCD_Return_Codes_e
+	@note Written a byte column at a time in unrotated buffer co-ordinates
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::drawSprite(const LCD_Sprite_t &sprite, int16_t x, int16_t y, uint8_t color)
+{
+	if (sprite.data == nullptr)
+	{
+		return reportError(LCD_BitmapNullptr, "Error drawSprite 1: Sprite data is not valid pointer");
+	}
+	uint8_t banks = (sprite.height + 7) / 8;
+	for (uint8_t k = 0; k < banks; k++)
+	{
+		uint8_t mask = 0xFF;
+		if ((k + 1) * 8 > sprite.height)
+			mask >>= ((k + 1) * 8 - sprite.height);
+		const uint8_t *pColumn = &sprite.data[k * sprite.width];
+		for (uint8_t i = 0; i < sprite.width; i++)
+			bankWrite(x + i, y + k * 8, pColumn[i], mask, color, color);
+	}
+	return LCD_Success;
+}
+
+/*!
+	@brief Fetch 8 vertical pixels of a sprite starting at any row
+	@param sprite The sprite
+	@param col column in sprite
+	@param row first row in sprite , may be negative
+	@return the 8 pixels LSB top, rows outside the sprite are zero
+*/
+static uint8_t spriteBits(const LCD_Sprite_t &sprite, int16_t col, int16_t row)
+{
+	if (row <= -8 || row >= sprite.height)
+		return 0;
+	if (row < 0)
+		return sprite.data[col] << -row;
+	uint8_t bank = row >> 3;
+	uint8_t shift = row & 7;
+	uint8_t bits = sprite.data[bank * sprite.width + col] >> shift;
+	if (shift && (bank + 1) * 8 < sprite.height)
+		bits |= sprite.data[(bank + 1) * sprite.width + col] << (8 - shift);
+	return bits;
+}
+
+/*!
+	@brief Pixel perfect collision test between two bank format sprites
+	@param a first sprite
+	@param ax x co-ord of first sprite
+	@param ay y co-ord of first sprite
+	@param b second sprite
+	@param bx x co-ord of second sprite
+	@param by y co-ord of second sprite
+	@param overlap optional, if not nullptr filled in with the bounding box of the colliding pixels
+	@return true if any set pixel of a lies on a set pixel of b
+	@details The overlapping columns are tested a byte at a time , AND of a bank of a
+		with the shift merged bits of b. Returns on the first hit when overlap is nullptr.
+*/
+bool NOKIA_5110_graphics::checkCollision(const LCD_Sprite_t &a, int16_t ax, int16_t ay,
+	const LCD_Sprite_t &b, int16_t bx, int16_t by, LCD_Rect_t *overlap)
+{
+	if (a.data == nullptr || b.data == nullptr)
+		return false;
+
+	int16_t x0 = (ax > bx) ? ax : bx;
+	int16_t x1 = LCD_min(ax + a.width, bx + b.width);
+	int16_t y0 = (ay > by) ? ay : by;
+	int16_t y1 = LCD_min(ay + a.height, by + b.height);
+	if (x0 >= x1 || y0 >= y1)
+		return false;
+
+	bool hit = false;
+	int16_t minX = x1, maxX = x0, minY = y1, maxY = y0;
+	uint8_t firstBank = (y0 - ay) / 8;
+	uint8_t lastBank = (y1 - 1 - ay) / 8;
+
+	for (uint8_t k = firstBank; k <= lastBank; k++)
+	{
+		int16_t rowY = ay + k * 8;
+		uint8_t mask = 0xFF;
+		if (rowY < y0) mask &= 0xFF << (y0 - rowY);
+		if (rowY + 8 > y1) mask &= 0xFF >> (rowY + 8 - y1);
+
+		const uint8_t *pColumn = &a.data[k * a.width];
+		for (int16_t x = x0; x < x1; x++)
+		{
+			uint8_t bitsA = pColumn[x - ax] & mask;
+			if (bitsA == 0) continue;
+			uint8_t hits = bitsA & spriteBits(b, x - bx, rowY - by);
+			if (hits == 0) continue;
+			if (overlap == nullptr) return true;
+			hit = true;
+			if (x < minX) minX = x;
+			if (x > maxX) maxX = x;
+			int16_t top = rowY + __builtin_ctz(hits);
+			int16_t bottom = rowY + 31 - __builtin_clz(hits);
+			if (top < minY) minY = top;
+			if (bottom > maxY) maxY = bottom;
+		}
+	}
+
+	if (hit)
+	{
+		overlap->x = minX;
+		overlap->y = minY;
+		overlap->w = maxX - minX + 1;
+		overlap->h = maxY - minY + 1;
+	}
+	return hit;
+}
+
+/*!
+	@brief Pixel perfect collision test between a bank format sprite and the buffer contents
+	@param sprite the sprite
+	@param x x co-ord of sprite
+	@param y y co-ord of sprite
+	@param overlap optional, if not nullptr filled in with the bounding box of the colliding pixels
+	@return true if any set pixel of the sprite lies on a set pixel in the buffer
+	@note Test before the sprite itself is drawn, else it collides with itself.
+*/
+bool NOKIA_5110_graphics::checkCollision(const LCD_Sprite_t &sprite, int16_t x, int16_t y, LCD_Rect_t *overlap)
+{
+	const LCD_Sprite_t screen = {_buffer, _bufferWidth, _bufferHeight};
+	return checkCollision(sprite, x, y, screen, 0, 0, overlap);
+}
+
+/*!
+	@brief Copy a rectangle of a bank format image into the buffer , replacing what is there
+	@param source The image , e.g. NOKIA_5110_Canvas::getSprite() , may be this buffer
+	@param sourceRect Rectangle of the image to copy , clipped to the image
+	@param x x co-ord in buffer of the top left of the rectangle , may be partly off screen
+	@param y y co-ord in buffer of the top left of the rectangle , may be partly off screen
+	@return LCD_Return_Codes_e
+	@details Unlike drawSprite both set and clear bits are copied. Each destination byte is
+		the shift merged source bits under a row mask, where source and destination rows
+		line up on a bank boundary whole banks are compared and memmove'd instead. Only bytes
+		that change are marked dirty. Works in unrotated buffer co-ordinates.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::blit(const LCD_Sprite_t &source, const LCD_Rect_t &sourceRect, int16_t x, int16_t y)
+{
+	if (source.data == nullptr || _buffer == nullptr)
+		return reportError(LCD_BitmapNullptr, "Error blit 1: Source or buffer is not valid pointer");
+
+	// clip the rectangle to the source , then to the buffer
+	int32_t sx0 = sourceRect.x, sy0 = sourceRect.y;
+	int32_t sx1 = sx0 + sourceRect.w, sy1 = sy0 + sourceRect.h;
+	if (sx0 < 0) { x -= sx0; sx0 = 0; }
+	if (sy0 < 0) { y -= sy0; sy0 = 0; }
+	if (sx1 > source.width) sx1 = source.width;
+	if (sy1 > source.height) sy1 = source.height;
+	int32_t x0 = x, y0 = y;
+	int32_t x1 = x + (sx1 - sx0), y1 = y + (sy1 - sy0);
+	if (x0 < 0) x0 = 0;
+	if (y0 < 0) y0 = 0;
+	if (x1 > _bufferWidth) x1 = _bufferWidth;
+	if (y1 > _bufferHeight) y1 = _bufferHeight;
+	if (x0 >= x1 || y0 >= y1)
+		return LCD_Success;
+
+	const int16_t dx = sx0 - x; // source column = buffer column + dx
+	const int16_t dy = sy0 - y; // source row = buffer row + dy
+	const uint8_t w = x1 - x0;
+	// the source may be this buffer , so banks and columns are visited in the order
+	// that reads each source byte before it is overwritten
+	const int8_t bankStep = (dy < 0) ? -1 : 1;
+	const uint8_t firstBank = (dy < 0) ? ((y1 - 1) >> 3) : (y0 >> 3);
+	const uint8_t bankCount = ((y1 - 1) >> 3) - (y0 >> 3) + 1;
+	for (uint8_t n = 0; n < bankCount; n++)
+	{
+		uint8_t bank = firstBank + n * bankStep;
+		int16_t rowY = bank * 8;
+		uint8_t mask = 0xFF;
+		if (rowY < y0) mask &= 0xFF << (y0 - rowY);
+		if (rowY + 8 > y1) mask &= 0xFF >> (rowY + 8 - y1);
+		uint8_t *pDest = &_buffer[bank * _bufferWidth + x0];
+		int16_t sourceRow = rowY + dy;
+
+		if (mask == 0xFF && (sourceRow & 7) == 0)
+		{
+			const uint8_t *pSrc = &source.data[(sourceRow >> 3) * source.width + x0 + dx];
+			uint8_t first = 0, last = w;
+			while (first < w && pSrc[first] == pDest[first]) first++;
+			if (first == w)
+				continue;
+			while (pSrc[last - 1] == pDest[last - 1]) last--;
+			memmove(pDest + first, pSrc + first, last - first);
+			markDirtyByte(x0 + first, bank);
+			markDirtyByte(x0 + last - 1, bank);
+			continue;
+		}
+
+		for (uint8_t n2 = 0; n2 < w; n2++)
+		{
+			uint8_t i = (dx < 0) ? w - 1 - n2 : n2;
+			uint8_t bits = spriteBits(source, x0 + i + dx, sourceRow);
+			uint8_t value = (pDest[i] & ~mask) | (bits & mask);
+			if (value != pDest[i])
+			{
+				pDest[i] = value;
+				markDirtyByte(x0 + i, bank);
+			}
+		}
+	}
+	return LCD_Success;
+}
+
+/*!
+	@brief Copy a rectangle of the buffer to another place in the buffer
+	@param sourceRect Rectangle to copy , clipped to the buffer
+	@param x x co-ord of the top left of the copy , may be partly off screen
+	@param y y co-ord of the top left of the copy , may be partly off screen
+	@return LCD_Return_Codes_e
+	@note The rectangles may overlap. Bank aligned moves are a memmove per bank, others
+		are shift merged across banks. Works in unrotated buffer co-ordinates.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::copyRect(const LCD_Rect_t &sourceRect, int16_t x, int16_t y)
+{
+	const LCD_Sprite_t screen = {_buffer, _bufferWidth, _bufferHeight};
+	return blit(screen, sourceRect, x, y);
+}
+
+/*!
+	@brief Scroll the whole buffer
+	@param dx Pixels to move right by , negative moves left
+	@param dy Pixels to move down by , negative moves up
+	@param color Color to fill the uncovered edges with
+	@return LCD_Return_Codes_e
+	@note Works in unrotated buffer co-ordinates.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::scroll(int16_t dx, int16_t dy, bool color)
+{
+	return scroll({0, 0, _bufferWidth, _bufferHeight}, dx, dy, color);
+}
+
+/*!
+	@brief Scroll the contents of a rectangle of the buffer
+	@param rect The rectangle , clipped to the buffer
+	@param dx Pixels to move right by , negative moves left
+	@param dy Pixels to move down by , negative moves up
+	@param color Color to fill the uncovered edges with
+	@return LCD_Return_Codes_e
+	@note Nothing outside the rectangle changes. Works in unrotated buffer co-ordinates.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::scroll(const LCD_Rect_t &rect, int16_t dx, int16_t dy, bool color)
+{
+	if (_buffer == nullptr)
+		return reportError(LCD_BitmapNullptr, "Error scroll 1: Buffer is not valid pointer");
+	int16_t x0 = (rect.x < 0) ? 0 : rect.x;
+	int16_t y0 = (rect.y < 0) ? 0 : rect.y;
+	int16_t x1 = LCD_min(rect.x + (int32_t)rect.w, (int32_t)_bufferWidth);
+	int16_t y1 = LCD_min(rect.y + (int32_t)rect.h, (int32_t)_bufferHeight);
+	if (x0 >= x1 || y0 >= y1 || (dx == 0 && dy == 0))
+		return LCD_Success;
+	const int16_t w = x1 - x0, h = y1 - y0;
+
+	if (abs(dx) < w && abs(dy) < h)
+	{
+		LCD_Rect_t source = {(int16_t)(dx < 0 ? x0 - dx : x0), (int16_t)(dy < 0 ? y0 - dy : y0),
+			(uint16_t)(w - abs(dx)), (uint16_t)(h - abs(dy))};
+		copyRect(source, source.x + dx, source.y + dy);
+	}
+	// fill the uncovered columns , then the uncovered rows
+	int16_t fillW = LCD_min(abs(dx), w);
+	int16_t fillH = LCD_min(abs(dy), h);
+	if (fillW)
+		fillBufferRect(dx > 0 ? x0 : x1 - fillW, y0, fillW, h, color);
+	if (fillH)
+		fillBufferRect(x0, dy > 0 ? y0 : y1 - fillH, w, fillH, color);
+	return LCD_Success;
+}
+
+/*!
+	@brief Fill a rectangle of the buffer a bank at a time
+	@param x x co-ord in buffer
+	@param y y co-ord in buffer
+	@param w width in pixels
+	@param h height in pixels
+	@param color color of rectangle
+	@note Clipped to the buffer. Each column byte is set or cleared under the row mask of
+		its bank and written only if it changes, so only changed bytes are marked dirty.
+		A one column rectangle is a vertical span, a byte per bank.
+		Works in unrotated buffer co-ordinates.
+*/
+void NOKIA_5110_graphics::fillBufferRect(uint8_t x, uint8_t y, uint8_t w, uint8_t h, bool color)
+{
+	if (_buffer == nullptr || w == 0 || h == 0 || x >= _bufferWidth || y >= _bufferHeight)
+		return;
+	if (w > _bufferWidth - x) w = _bufferWidth - x;
+	if (h > _bufferHeight - y) h = _bufferHeight - y;
+	const uint8_t y1 = y + h;
+	for (uint8_t bank = y >> 3; bank <= ((y1 - 1) >> 3); bank++)
+	{
+		uint8_t rowY = bank * 8;
+		uint8_t mask = 0xFF;
+		if (rowY < y) mask &= 0xFF << (y - rowY);
+		if (rowY + 8 > y1) mask &= 0xFF >> (rowY + 8 - y1);
+		uint8_t *pByte = &_buffer[bank * _bufferWidth + x];
+		for (uint8_t i = 0; i < w; i++)
+		{
+			uint8_t value = color ? (pByte[i] | mask) : (pByte[i] & ~mask);
+			if (value != pByte[i])
+			{
+				pByte[i] = value;
+				markDirtyByte(x + i, bank);
+			}
+		}
+	}
+}
+
+/*!
+	@brief Draw a tile map over the whole buffer
+	@param tileMap The tile map
+	@param scrollX x scroll offset into map in pixels
+	@param scrollY y scroll offset into map in pixels
+	@return LCD_Return_Codes_e
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::drawTileMap(const LCD_TileMap_t &tileMap, uint16_t scrollX, uint16_t scrollY)
+{
+	return drawTileMap(tileMap, scrollX, scrollY, 0, 0, _bufferWidth, _bufferHeight / 8);
+}
+
+/*!
+	@brief Draw a tile map into a bank aligned view port of the buffer
+	@param tileMap The tile map
+	@param scrollX x scroll offset into map in pixels, the map wraps around
+	@param scrollY y scroll offset into map in pixels, the map wraps around
+	@param x x co-ord of view port
+	@param bank first bank (y/8) of view port
+	@param w width of view port in pixels
+	@param banks height of view port in banks
+	@return LCD_Return_Codes_e
+	@details Tiles replace the buffer contents. With scrollY a multiple of 8 tile columns
+		are copied straight into the bank, else each byte is shift merged from the two
+		tile rows that straddle the bank.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::drawTileMap(const LCD_TileMap_t &tileMap, uint16_t scrollX, uint16_t scrollY,
+	uint8_t x, uint8_t bank, uint8_t w, uint8_t banks)
+{
+	if (tileMap.tiles == nullptr || tileMap.map == nullptr || _buffer == nullptr)
+	{
+		return reportError(LCD_BitmapNullptr, "Error drawTileMap 1: Tile map is not valid pointer");
+	}
+	if (tileMap.columns == 0 || tileMap.rows == 0 || x + w > _bufferWidth || (bank + banks) * 8 > _bufferHeight)
+	{
+		return reportError(LCD_BitmapScreenBounds, "Error drawTileMap 2: View port out of bounds, check x bank w and banks");
+	}
+
+	const uint16_t mapWidth = tileMap.columns * 8;
+	const uint16_t mapHeight = tileMap.rows * 8;
+	const uint8_t shift = scrollY & 7;
+	scrollX %= mapWidth;
+
+	for (uint8_t k = 0; k < banks; k++)
+	{
+		uint8_t tileRow = ((scrollY + k * 8) % mapHeight) >> 3;
+		const uint8_t *pRow = &tileMap.map[tileRow * tileMap.columns];
+		const uint8_t *pNextRow = &tileMap.map[((tileRow + 1) % tileMap.rows) * tileMap.columns];
+		uint8_t *pDest = &_buffer[(bank + k) * _bufferWidth + x];
+		uint16_t mapX = scrollX;
+		uint8_t col = 0;
+
+		while (col < w)
+		{
+			uint8_t tileCol = mapX >> 3;
+			uint8_t tileX = mapX & 7;
+			uint8_t run = 8 - tileX;
+			if (run > w - col) run = w - col;
+
+			const uint8_t *pTile = &tileMap.tiles[pRow[tileCol] * 8 + tileX];
+			markDirtyByte(x + col, bank + k);
+			markDirtyByte(x + col + run - 1, bank + k);
+			if (shift == 0)
+			{
+				memcpy(pDest + col, pTile, run);
+			} else {
+				const uint8_t *pNextTile = &tileMap.tiles[pNextRow[tileCol] * 8 + tileX];
+				for (uint8_t i = 0; i < run; i++)
+					pDest[col + i] = (pTile[i] >> shift) | (pNextTile[i] << (8 - shift));
+			}
+			col += run;
+			mapX += run;
+			if (mapX >= mapWidth) mapX = 0;
+		}
+	}
+	return LCD_Success;
+}
+
+/*! Bit expansion tables for scaled text, a nibble of a glyph column expands to
+	4*size bits with each bit repeated size times, indexed [size][nibble] */
+struct LCD_ScaleLUT_t
+{
+	uint32_t bits[LCD_MAX_SCALE_LUT + 1][16]; /**< expanded nibbles */
+};
+
+/*!
+	@brief Build the scaled text bit expansion tables at compile time
+	@return The tables
+*/
+static constexpr LCD_ScaleLUT_t makeScaleLUT(void)
+{
+	LCD_ScaleLUT_t lut{};
+	for (uint8_t size = 1; size <= LCD_MAX_SCALE_LUT; size++)
+		for (uint8_t nibble = 0; nibble < 16; nibble++)
+			for (uint8_t bit = 0; bit < 4; bit++)
+				if (nibble & (1 << bit))
+					lut.bits[size][nibble] |= ((1UL << size) - 1) << (bit * size);
+	return lut;
+}
+
+static constexpr LCD_ScaleLUT_t ScaleLUT = makeScaleLUT(); /**< Scaled text expansion tables */
+
+/*!
+	@brief  Draw a single character font 1-6
 	@param    x   Bottom left corner x coordinate
 	@param    y   Bottom left corner y coordinate
 	@param    character   The 8-bit font-indexed character (likely ascii)
@@ -601,10 +2233,9 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawChar(uint16_t x, uint16_t y, uint8_t
 {
 
 	// 1. Check for wrong font
-	if (_FontNumber >= LCDFont_Bignum)
+	if (_pCurrentFont->layout != LCDFontLayout_SingleBank)
 	{
-		std::cout<< "Error drawChar 1: Wrong font selected, must be font 1-6 "<< std::endl;
-		return LCD_WrongFont;
+		return reportError(LCD_WrongFont, "Error drawChar 1: Wrong font selected, must be font 1-6");
 	}
 	// 2. Check for screen out of  bounds
 	if((x >= _width)            || // Clip right
@@ -612,52 +2243,56 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawChar(uint16_t x, uint16_t y, uint8_t
 	((x + (_CurrentFontWidth+1) * size - 1) < 0) || // Clip left
 	((y + _CurrentFontheight  * size - 1) < 0))   // Clip top
 	{
-		std::cout<< "Error drawChar 2: Co-ordinates out of bounds " << std::endl;
-		return LCD_CharScreenBounds;
+		return reportError(LCD_CharScreenBounds, "Error drawChar 2: Co-ordinates out of bounds");
 	}
-	// 3. Check for character out of font range bounds
-	if ( character < _CurrentFontoffset || character >= (_CurrentFontLength+ _CurrentFontoffset))
+	// 3. Check for character out of font range bounds, or left out of a proportional font
+	if ( character < _CurrentFontoffset || character >= (_CurrentFontLength+ _CurrentFontoffset) || getCharWidth(character) == 0)
 	{
-		std::cout<< "Error drawChar 3: Character out of Font bounds " << character << " " <<+_CurrentFontoffset <<  +(_CurrentFontLength + _CurrentFontoffset) << std::endl;
-		return LCD_CharFontASCIIRange;
+		return reportError(LCD_CharFontASCIIRange, "Error drawChar 3: Character out of Font bounds");
 	}
+	drawCharUnchecked(x, y, character, color, bg, size);
+	return LCD_Success;
+}
 
-	for (int8_t i=0; i<(_CurrentFontWidth+1); i++ )
-	{
-	uint8_t line;
-	if (i == _CurrentFontWidth)
-	{
-		line = 0x0;
-	}
-	else
+/*!
+	@brief  Draw a single character font 1-6 , no checks
+	@param    x   x coordinate , less than _width
+	@param    y   y coordinate , less than _height
+	@param    character  Character in the current font , getCharWidth(character) not 0
+	@param   color foreground color
+	@param   bg   background color
+	@param size Text size
+	@note For callers that have already checked their input, e.g. pre-measured text runs.
+		Called by drawChar and print once checked.
+*/
+void NOKIA_5110_graphics::drawCharUnchecked(uint16_t x, uint16_t y, uint8_t character, uint8_t color, uint8_t bg, uint8_t size)
+{
+	uint8_t glyphWidth;
+	const uint8_t *pGlyph = getGlyph(character, glyphWidth);
+
+	// Fast path, glyph columns are already bank format so are magnified by table lookup
+	// and copied or shift merged straight into the buffer a byte at a time
+	if (size <= LCD_MAX_SCALE_LUT && _buffer != nullptr && _LCD_rotate == LCD_Degrees_0)
 	{
-		switch (_FontNumber)
+		const uint32_t *pLUT = ScaleLUT.bits[size];
+		for (uint8_t i = 0; i < (glyphWidth+1); i++)
 		{
-			case LCDFont_Default:
-				line = pFontDefaultptr[(character - _CurrentFontoffset) * _CurrentFontWidth + i];
-			break;
-			case LCDFont_Thick:
-				line = pFontThickptr[(character - _CurrentFontoffset) * _CurrentFontWidth + i];
-			break;
-			case LCDFont_SevenSeg:
-				line = pFontSevenSegptr[(character - _CurrentFontoffset) * _CurrentFontWidth + i];
-			break;
-			case LCDFont_Wide:
-				line = pFontWideptr[(character - _CurrentFontoffset) * _CurrentFontWidth + i];
-			break;
-			case LCDFont_Tiny:
-				line =pFontTinyptr[(character - _CurrentFontoffset) * _CurrentFontWidth + i];
-			break;
-			case LCDFont_Homespun:
-				line = pFontHomeSpunptr[(character - _CurrentFontoffset) * _CurrentFontWidth + i];
-			break;
-			default:
-				std::cout<< "Error drawChar 4: Wrong font number , must be 1-6" << std::endl;
-				return LCD_WrongFont;
-			break;
-		}//switch font linenumber
+			uint8_t line = (i == glyphWidth) ? 0x00 : pGlyph[i];
+			uint64_t column = pLUT[line & 0x0F] | ((uint64_t)pLUT[line >> 4] << (4 * size));
+			for (uint8_t k = 0; k < size; k++)
+			{
+				uint8_t bits = column >> (k * 8);
+				for (uint8_t r = 0; r < size; r++)
+					bankWrite(x + i * size + r, y + k * 8, bits, 0xFF, color, bg);
+			}
+		}
+		return;
 	}
 
+	for (int16_t i=0; i<(glyphWidth+1); i++ )
+	{
+		uint8_t line = (i == glyphWidth) ? 0x00 : pGlyph[i];
+
 		for (int8_t j = 0; j<_CurrentFontheight; j++)
 		{
 			if (line & 0x1) {
@@ -676,7 +2311,6 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawChar(uint16_t x, uint16_t y, uint8_t
 			line >>= 1;
 		}
 	} // for loop
-	return LCD_Success;
 }
 
 /*!
@@ -729,6 +2363,18 @@ void NOKIA_5110_graphics::setTextColor(uint8_t c, uint8_t b) {
 */
 void NOKIA_5110_graphics::setTextWrap(bool w) {_textWrap = w;}
 
+/*!
+	@brief  Set text encoding for print/write and drawText
+	@param  utf8 true to decode text as UTF-8 , false (default) for single byte character codes
+	@note In UTF-8 mode ASCII is drawn as is , other code points are looked up in the
+		font's code point table, one not in the font is drawn as '?' (or ' ') instead.
+*/
+void NOKIA_5110_graphics::setTextUTF8(bool utf8)
+{
+	_textUTF8 = utf8;
+	_utf8Pending = 0;
+}
+
 /*!
 	@brief     Get current width of display, can vary with rotation
 	@returns   _width
@@ -761,27 +2407,23 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawBitmap(uint16_t x, uint16_t y, const
 	// 1. Completely out of bounds?
 	if (x > _width || y > _height)
 	{
-		std::cout<< "Error drawBitmap 1: Bitmap co-ord out of bounds, check x and y" << std::endl;
-		return LCD_BitmapScreenBounds ;
+		return reportError(LCD_BitmapScreenBounds, "Error drawBitmap 1: Bitmap co-ord out of bounds, check x and y");
 	}
 	// 2. bitmap weight and height
 	if (w > _width || h > _height)
 	{
-		std::cout<< "Error drawBitmap 2: Bitmap is larger than screen, check w and h" << std::endl;
-		return LCD_BitmapLargerThanScreen;
+		return reportError(LCD_BitmapLargerThanScreen, "Error drawBitmap 2: Bitmap is larger than screen, check w and h");
 	}
 	// 3. bitmap is null
 	if(bitmap == nullptr)
 	{
-		std::cout<< "Error drawBitmap 3: Bitmap is is not valid pointer" << std::endl;
-		return LCD_BitmapNullptr;
+		return reportError(LCD_BitmapNullptr, "Error drawBitmap 3: Bitmap is not valid pointer");
 	}
 
 	// 4.check bitmap size
 	if(sizeOfBitmap != (w * (h/8)))
 	{
-		std::cout<< "Error drawBitmap 4: Bitmap size is incorrect: " <<  sizeOfBitmap << ". Check w & h (w*(h/8):" << w << " " << h << std::endl;
-		return LCD_BitmapSize;
+		return reportError(LCD_BitmapSize, "Error drawBitmap 4: Bitmap size is incorrect, check w & h (w*(h/8))");
 	}
 
 	// Vertical byte bitmaps
@@ -816,92 +2458,224 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawBitmap(uint16_t x, uint16_t y, const
 /*!
 	@brief  Set the font number
 	@param  FontNumber LCDFont_e  enum , fontnumber 1-12
+	@note if wrong font number passed in, set to default
 */
 void NOKIA_5110_graphics::SetFontNum(LCDFontType_e FontNumber) {
 
-	_FontNumber = FontNumber;
+	if (FontNumber < LCDFont_Default || FontNumber > LCDFont_Dedica)
+		FontNumber = LCDFont_Default;
+	SetFont(&LCDFontTable[FontNumber]);
+}
 
-	switch (_FontNumber) {
-	case LCDFont_Default:  // Norm default 5 by 8
-		_CurrentFontWidth = LCDFontWidth_5;
-		_CurrentFontoffset =  LCDFontOffset_Extend;
-		_CurrentFontheight = LCDFontHeight_8;
-		_CurrentFontLength = LCDFontLenAll;
-	break;
-	case LCDFont_Thick: // Thick 7 by 8 (NO LOWERCASE LETTERS)
-		_CurrentFontWidth = LCDFontWidth_7;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_8;
-		_CurrentFontLength = LCDFontLenAlphaNumNoLCase;
-	break;
-	case LCDFont_SevenSeg:  // Seven segment 4 by 8
-		_CurrentFontWidth = LCDFontWidth_4;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_8;
-		_CurrentFontLength = LCDFontLenAlphaNum;
-	break;
-	case LCDFont_Wide : // Wide  8 by 8 (NO LOWERCASE LETTERS)
-		_CurrentFontWidth = LCDFontWidth_8;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_8;
-		_CurrentFontLength = LCDFontLenAlphaNumNoLCase;
-	break;
-	case LCDFont_Tiny:  // tiny 3 by 8
-		_CurrentFontWidth = LCDFontWidth_3;
-		_CurrentFontoffset =  LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_8;
-		_CurrentFontLength = LCDFontLenAlphaNum;
-	break;
-	case LCDFont_Homespun: // homespun 7 by 8
-		_CurrentFontWidth = LCDFontWidth_7;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_8;
-		_CurrentFontLength = LCDFontLenAlphaNum;
-	break;
-	case LCDFont_Bignum : // big nums 16 by 32 (NUMBERS)
-		_CurrentFontWidth = LCDFontWidth_16;
-		_CurrentFontoffset = LCDFontOffset_Minus;
-		_CurrentFontheight = LCDFontHeight_32;
-		_CurrentFontLength = LCDFontLenNumeric;
-	break;
-	case LCDFont_Mednum: // med nums 16 by 16 (NUMBERS)
-		_CurrentFontWidth = LCDFontWidth_16;
-		_CurrentFontoffset =  LCDFontOffset_Minus;
-		_CurrentFontheight = LCDFontHeight_16;
-		_CurrentFontLength = LCDFontLenNumeric;
-	break;
-	case LCDFont_ArialRound: // Arial round 16 by 24
-		_CurrentFontWidth = LCDFontWidth_16;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_24;
-		_CurrentFontLength = LCDFontLenAlphaNum;
-	break;
-	case LCDFont_ArialBold: // Arial bold  16 by 16
-		_CurrentFontWidth = LCDFontWidth_16;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_16;
-		_CurrentFontLength = LCDFontLenAlphaNum;
-	break;
-	case LCDFont_Mia: // mia  8 by 16
-		_CurrentFontWidth = LCDFontWidth_8;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_16;
-		_CurrentFontLength = LCDFontLenAlphaNum;
-	break;
-	case LCDFont_Dedica: // dedica  6 by 12
-		_CurrentFontWidth = LCDFontWidth_6;
-		_CurrentFontoffset = LCDFontOffset_Space;
-		_CurrentFontheight = LCDFontHeight_12;
-		_CurrentFontLength = LCDFontLenAlphaNum;
-	break;
-	default: // if wrong font num passed in,  set to default
-		_CurrentFontWidth = LCDFontWidth_5;
-		_CurrentFontoffset =  LCDFontOffset_Extend;
-		_CurrentFontheight = LCDFontHeight_8;
-		_FontNumber = LCDFont_Default;
-		_CurrentFontLength = LCDFontLenAll;
-	break;
+/*!
+	@brief  Set the font from a font descriptor, built in or user supplied
+	@param  pFont pointer to font descriptor, must remain valid while the font is in use
+	@return LCD_Return_Codes_e
+	@note A LCDFontLayout_SingleBank font is drawn by the methods for fonts 1-6 ,
+		a LCDFontLayout_MultiBank font by the methods for fonts 7-12.
+		Passing getFont() restores a font saved earlier, built in or user.
+*/
+LCD_Return_Codes_e NOKIA_5110_graphics::SetFont(const LCDFont_t *pFont) {
+
+	if (pFont == nullptr || pFont->data == nullptr || pFont->width == 0 || pFont->height == 0 ||
+		(pFont->layout == LCDFontLayout_SingleBank && pFont->height > 8) ||
+		((pFont->widths == nullptr) != (pFont->offsets == nullptr)))
+	{
+		return reportError(LCD_FontInvalid, "Error SetFont 1: Font descriptor is not valid");
+	}
+	_pCurrentFont = pFont;
+	_FontNumber = 0;
+	for (uint8_t i = LCDFont_Default; i <= LCDFont_Dedica; i++)
+		if (pFont == &LCDFontTable[i]) _FontNumber = i;
+	_CurrentFontWidth = pFont->width;
+	_CurrentFontoffset = pFont->offset;
+	_CurrentFontheight = pFont->height;
+	_CurrentFontLength = pFont->length;
+	return LCD_Success;
+}
+
+/*!
+	@brief Look up the glyph of a character in the current font
+	@param character The character , must be in the current font , getCharWidth(character) not 0
+	@param width Returns the width of the glyph in pixels
+	@return pointer to the glyph data, banks of 'width' column bytes , LSB at top
+	@note For rendering text off screen, e.g. NOKIA_5110_Ticker
+*/
+const uint8_t *NOKIA_5110_graphics::getGlyph(uint8_t character, uint8_t &width)
+{
+	uint8_t index = character - _CurrentFontoffset;
+	if (_pCurrentFont->widths == nullptr)
+	{
+		width = _CurrentFontWidth;
+		return _pCurrentFont->data + index * _pCurrentFont->stride;
 	}
+	width = _pCurrentFont->widths[index];
+	return _pCurrentFont->data + _pCurrentFont->offsets[index];
+}
+
+/*!
+	@brief Get the width of a character in the current font
+	@param character The character
+	@return Width of the glyph in pixels at text size 1 without the padding column
+		added to fonts 1-6, 0 if the character is outside the font's ASCII range
+	@note Proportional fonts have a width per glyph, fixed fonts return the font width
+*/
+uint8_t NOKIA_5110_graphics::getCharWidth(uint8_t character)
+{
+	if (character < _CurrentFontoffset || character >= (_CurrentFontLength + _CurrentFontoffset))
+		return 0;
+	if (_pCurrentFont->widths == nullptr)
+		return _CurrentFontWidth;
+	return _pCurrentFont->widths[character - _CurrentFontoffset];
+}
+
+/*!
+	@brief Get the distance the cursor moves after drawing a character in the current font
+	@param character The character
+	@param size Text size , fonts 1-6 only , ignored by fonts 7-12
+	@return Advance in pixels, includes the padding column of fonts 1-6 , 0 if not in the font
+*/
+uint8_t NOKIA_5110_graphics::getCharAdvance(uint8_t character, uint8_t size)
+{
+	uint8_t width = getCharWidth(character);
+	if (width == 0)
+		return 0;
+	if (_pCurrentFont->layout == LCDFontLayout_SingleBank)
+		return size * (width + 1);
+	return width;
+}
+
+/*!
+	@brief Get the height of a line of text in the current font
+	@param size Text size , fonts 1-6 only , ignored by fonts 7-12
+	@return Line height in pixels
+*/
+uint8_t NOKIA_5110_graphics::getLineHeight(uint8_t size)
+{
+	if (_pCurrentFont->layout == LCDFontLayout_SingleBank)
+		return size * _CurrentFontheight;
+	return _CurrentFontheight;
+}
+
+/*!
+	@brief Get the descriptor of the current font
+	@return pointer to the font descriptor
+*/
+const LCDFont_t *NOKIA_5110_graphics::getFont() {return _pCurrentFont;}
+
+/*!
+	@brief Read the next character to draw from a string
+	@param pText Pointer into the string, moved past the bytes read
+	@param character Returns the character code to draw in the current font
+	@return false at the end of the string
+	@note Single byte characters are returned as is, in UTF-8 mode a code point is
+		decoded and mapped, see setTextUTF8. Used by drawText and measureText.
+*/
+bool NOKIA_5110_graphics::nextChar(const char *&pText, uint8_t &character)
+{
+	if (!_textUTF8)
+	{
+		if (*pText == '\0')
+			return false;
+		character = *pText++;
+		return true;
+	}
+	uint32_t codePoint = 0;
+	uint8_t pending = 0;
+	while (*pText != '\0')
+	{
+		if (decodeUTF8(*pText++, codePoint, pending) && mapCodePoint(codePoint, character))
+			return true;
+	}
+	return false;
+}
+
+/*!
+	@brief Feed the next byte of a text stream , as print does
+	@param byte The byte
+	@param codePoint Decoder state , code point being decoded
+	@param pending Decoder state , continuation bytes expected , 0 at start
+	@param character Returns the character code to draw in the current font
+	@return true if character is ready , false if more bytes are needed or the code point is skipped
+	@note Single byte characters are returned as is. In UTF-8 mode a code point is decoded
+		and mapped, except '\n' and '\r' which are returned unmapped, see setTextUTF8.
+*/
+bool NOKIA_5110_graphics::nextChar(uint8_t byte, uint32_t &codePoint, uint8_t &pending, uint8_t &character)
+{
+	if (!_textUTF8)
+	{
+		character = byte;
+		return true;
+	}
+	if (!decodeUTF8(byte, codePoint, pending))
+		return false;
+	if (codePoint == '\n' || codePoint == '\r')
+	{
+		character = codePoint;
+		return true;
+	}
+	return mapCodePoint(codePoint, character);
+}
+
+/*!
+	@brief Measure the width of a string in the current font without drawing it
+	@param pText pointer to character array
+	@param size Text size , fonts 1-6 only , ignored by fonts 7-12
+	@return Width in pixels of the string drawn on one line, the sum of its character advances
+	@note For wrapping and alignment see NOKIA_5110_TextLayout
+*/
+uint16_t NOKIA_5110_graphics::measureText(const char *pText, uint8_t size)
+{
+	if (pText == nullptr)
+		return 0;
+	uint16_t width = 0;
+	uint8_t character;
+	while (nextChar(pText, character))
+		width += getCharAdvance(character, size);
+	return width;
+}
+
+/*!
+	@brief Find the character code of a code point's glyph in the current font
+	@param codePoint Unicode code point
+	@param character Returns the character code to draw
+	@return false if the font has no glyph for it and no replacement , the code point is skipped
+	@note ASCII maps to itself , others by binary search of the font's code point table.
+		A code point not in the font is replaced by '?' , or ' ' if the font has no '?'.
+*/
+bool NOKIA_5110_graphics::mapCodePoint(uint32_t codePoint, uint8_t &character)
+{
+	if (codePoint < 0x80 && getCharWidth(codePoint) != 0)
+	{
+		character = codePoint;
+		return true;
+	}
+	const LCDFontCodePoint_t *pTable = _pCurrentFont->unicode;
+	if (pTable != nullptr && codePoint <= 0xFFFF)
+	{
+		uint8_t low = 0, high = _pCurrentFont->unicodeLength;
+		while (low < high)
+		{
+			uint8_t mid = (low + high) / 2;
+			if (pTable[mid].codePoint < codePoint)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+		if (low < _pCurrentFont->unicodeLength && pTable[low].codePoint == codePoint &&
+			getCharWidth(pTable[low].character) != 0)
+		{
+			character = pTable[low].character;
+			return true;
+		}
+	}
+	if (getCharWidth('?') != 0)
+		character = '?';
+	else if (getCharWidth(' ') != 0)
+		character = ' ';
+	else
+		return false;
+	return true;
 }
 
 /*!
@@ -918,22 +2692,22 @@ void NOKIA_5110_graphics::SetFontNum(LCDFontType_e FontNumber) {
 LCD_Return_Codes_e  NOKIA_5110_graphics::drawText(uint8_t x, uint8_t y, char* pText, uint8_t color, uint8_t bg, uint8_t size) {
 
 	// check Correct font number
-	if (_FontNumber >= LCDFont_Bignum)
+	if (_pCurrentFont->layout != LCDFontLayout_SingleBank)
 	{
-		std::cout<< "Error drawText 1: Wrong font number , must be 1-6" << std::endl;
-		return LCD_WrongFont;
+		return reportError(LCD_WrongFont, "Error drawText 1: Wrong font number, must be 1-6");
 	}
 	// Check for null pointer
 	if(pText == nullptr)
 	{
-		std::cout<< "Error drawText 2: String array is not valid pointer" << std::endl;
-		return LCD_CharArrayNullptr;
+		return reportError(LCD_CharArrayNullptr, "Error drawText 2: String array is not valid pointer");
 	}
 	LCD_Return_Codes_e DrawCharReturnCode;
 	uint8_t lcursorX = x;
 	uint8_t lcursorY = y;
+	const char *pNext = pText;
+	uint8_t character;
 
-	while (*pText != '\0')
+	while (nextChar(pNext, character))
 	{
 		if (_textWrap  && ((lcursorX + size * _CurrentFontWidth) > _width))
 		{
@@ -941,16 +2715,14 @@ LCD_Return_Codes_e  NOKIA_5110_graphics::drawText(uint8_t x, uint8_t y, char* pT
 			lcursorY = lcursorY + size * 7 + 3;
 			if (lcursorY > _height) lcursorY = _height;
 		}
-		DrawCharReturnCode = drawChar(lcursorX, lcursorY, *pText, color, bg, size);
+		DrawCharReturnCode = drawChar(lcursorX, lcursorY, character, color, bg, size);
 		
 		if (DrawCharReturnCode != LCD_Success)
 		{
-			std::cout<< "Error drawText 3: Method drawChar failed" << std::endl;
-			return DrawCharReturnCode;
+			return DrawCharReturnCode; // reported by drawChar
 		}
-		lcursorX = lcursorX + size * (_CurrentFontWidth + 1);
+		lcursorX = lcursorX + size * (getCharWidth(character) + 1);
 		if (lcursorX > _width) lcursorX = _width;
-		pText++;
 	}
 	return LCD_Success;
 }
@@ -967,30 +2739,16 @@ LCD_Return_Codes_e  NOKIA_5110_graphics::drawText(uint8_t x, uint8_t y, char* pT
 */
 LCD_Return_Codes_e NOKIA_5110_graphics::drawChar(uint8_t x, uint8_t y, uint8_t character, uint8_t color , uint8_t bg)
 {
-	uint8_t FontSizeMod = 0;
 	// Check user input
 	// 1. Check for wrong font
-	switch (_FontNumber)
-	{
-		case LCDFont_Bignum:
-		case LCDFont_Mednum:
-		case LCDFont_ArialRound:
-		case LCDFont_ArialBold:
-			FontSizeMod  = 2;
-		break;
-		case LCDFont_Mia:
-		case LCDFont_Dedica:
-			FontSizeMod  = 1;
-		break;
-		default:
-			return LCD_WrongFont;
-		break;
-	}
-	// 2. Check for character out of font bounds
-	if ( character < _CurrentFontoffset || character >= (_CurrentFontLength+ _CurrentFontoffset))
-	{
-		std::cout<< "Error drawChar 2: Character out of Font bounds " << character << " " <<+_CurrentFontoffset  <<  +(_CurrentFontLength + _CurrentFontoffset) << std::endl;
-		return LCD_CharFontASCIIRange;
+	if (_pCurrentFont->layout != LCDFontLayout_MultiBank)
+	{
+		return LCD_WrongFont;
+	}
+	// 2. Check for character out of font bounds, or left out of a proportional font
+	if ( character < _CurrentFontoffset || character >= (_CurrentFontLength+ _CurrentFontoffset) || getCharWidth(character) == 0)
+	{
+		return reportError(LCD_CharFontASCIIRange, "Error drawChar 2: Character out of Font bounds");
 	}
 	// 3. Check for screen out of  bounds
 	if((x >= _width)            || // Clip right
@@ -998,50 +2756,55 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawChar(uint8_t x, uint8_t y, uint8_t c
 	((x + _CurrentFontWidth+1) < 0) || // Clip left
 	((y + _CurrentFontheight) < 0))   // Clip top
 	{
-		std::cout<< "Error drawChar 3: Co-ordinates out of bounds " << std::endl;
-		return LCD_CharScreenBounds;
+		return reportError(LCD_CharScreenBounds, "Error drawChar 3: Co-ordinates out of bounds");
 	}
+	drawCharUnchecked(x, y, character, color, bg);
+	return LCD_Success;
+}
 
-	uint8_t i = 0;
-	uint8_t j = 0;
-	uint8_t ctemp = 0;
-	uint8_t y0 = y;
+/*!
+	@brief writes a character on the LCD , font 7-12 , no checks
+	@param x x-co-ord , less than _width
+	@param y y-co-ord , less than _height
+	@param character Character in the current font , getCharWidth(character) not 0
+	@param color foreground color
+	@param bg background color
+	@note For callers that have already checked their input, e.g. pre-measured text runs.
+		Called by drawChar and print once checked.
+*/
+void NOKIA_5110_graphics::drawCharUnchecked(uint8_t x, uint8_t y, uint8_t character, uint8_t color, uint8_t bg)
+{
+	uint8_t glyphWidth;
+	const uint8_t *pGlyph = getGlyph(character, glyphWidth);
+	const uint8_t banks = (_CurrentFontheight + 7) / 8;
 
-	for (i = 0; i < (_CurrentFontheight*FontSizeMod); i++)
+	// Fast path, glyph is bank format so is copied or shift merged into the buffer a column byte at a time
+	// Background is always drawn, so if bg equals color the whole glyph cell is filled
+	if (_buffer != nullptr && _LCD_rotate == LCD_Degrees_0)
 	{
-		switch (_FontNumber)
+		for (uint8_t k = 0; k < banks; k++)
 		{
-			case LCDFont_Bignum: ctemp = pFontBigNumptr[character - _CurrentFontoffset][i]; break;
-			case LCDFont_Mednum: ctemp = pFontMedNumptr[character - _CurrentFontoffset][i]; break;
-			case LCDFont_ArialRound: ctemp = pFontArial16x24ptr[character - _CurrentFontoffset][i]; break;
-			case LCDFont_ArialBold: ctemp = pFontArial16x16ptr[character - _CurrentFontoffset][i]; break;
-			case LCDFont_Mia: ctemp = pFontMia8x16ptr[character - _CurrentFontoffset][i]; break;
-			case LCDFont_Dedica: ctemp = pFontDedica8x12ptr[character - _CurrentFontoffset][i]; break;
-			default :
-				std::cout<< "Error drawChar 4: Wrong font selected, must be font 7-12"<< std::endl;
-				return LCD_WrongFont;
-			break;
+			uint8_t mask = 0xFF;
+			if ((k + 1) * 8 > _CurrentFontheight)
+				mask >>= ((k + 1) * 8 - _CurrentFontheight);
+			for (uint8_t i = 0; i < glyphWidth; i++)
+				bankWrite(x + i, y + k * 8, (bg == color) ? 0xFF : pGlyph[k * glyphWidth + i], mask, color, bg);
 		}
+		return;
+	}
 
-		for (j = 0; j < 8; j++)
+	for (uint8_t i = 0; i < glyphWidth; i++)
+	{
+		for (uint8_t j = 0; j < _CurrentFontheight; j++)
 		{
-			if (ctemp & 0x80)
+			if (pGlyph[(j >> 3) * glyphWidth + i] & (1 << (j & 7)))
 			{
-				LCDDrawPixel(x, y, color);
+				LCDDrawPixel(x + i, y + j, color);
 			} else {
-				LCDDrawPixel(x, y, bg);
-			}
-			ctemp <<= 1;
-			y++;
-			if ((y - y0) == _CurrentFontheight)
-			{
-				y = y0;
-				x++;
-				break;
+				LCDDrawPixel(x + i, y + j, bg);
 			}
 		}
 	}
-	return LCD_Success;
 }
 
 /*!
@@ -1057,20 +2820,20 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawChar(uint8_t x, uint8_t y, uint8_t c
 LCD_Return_Codes_e NOKIA_5110_graphics::drawText(uint8_t x, uint8_t y, char* pText, uint8_t color, uint8_t bg)
 {
 	// Check correct font number
-	if (_FontNumber < LCDFont_Bignum)
+	if (_pCurrentFont->layout != LCDFontLayout_MultiBank)
 	{
-		std::cout<< "Error drawText 1: Wrong font selected, must be > font 7 " << std::endl;
-		return LCD_WrongFont;
+		return reportError(LCD_WrongFont, "Error drawText 1: Wrong font selected, must be > font 7");
 	}
 
 	// Check for null pointer
 	if(pText == nullptr)
 	{
-		std::cout<< "Error drawText 2 :String array is not valid pointer" << std::endl;
-		return LCD_CharArrayNullptr;
+		return reportError(LCD_CharArrayNullptr, "Error drawText 2: String array is not valid pointer");
 	}
 	LCD_Return_Codes_e DrawCharReturnCode;
-	while (*pText != '\0')
+	const char *pNext = pText;
+	uint8_t character;
+	while (nextChar(pNext, character))
 	{
 	if (x > (_width - _CurrentFontWidth ))
 	{
@@ -1081,14 +2844,12 @@ LCD_Return_Codes_e NOKIA_5110_graphics::drawText(uint8_t x, uint8_t y, char* pTe
 			y = x = 0;
 		}
 	}
-	DrawCharReturnCode = drawChar(x, y, *pText, color, bg);
+	DrawCharReturnCode = drawChar(x, y, character, color, bg);
 	if(DrawCharReturnCode  != LCD_Success)
 	{
-		std::cout<< "Error drawText 3: Method drawChar failed" << std::endl;
-		return DrawCharReturnCode;
-	}
-	x += _CurrentFontWidth ;
-	pText++;
+		return DrawCharReturnCode; // reported by drawChar
+		}
+	x += getCharWidth(character);
 	}
 	return LCD_Success;
 }
@@ -1102,13 +2863,13 @@ void NOKIA_5110_graphics::setRotation(LCD_rotate_e CurrentRotation) {
 	switch(CurrentRotation) {
 	case LCD_Degrees_0:
 	case LCD_Degrees_180:
-		_width  = LCDWIDTH;
-		_height = LCDHEIGHT;
+		_width  = _bufferWidth;
+		_height = _bufferHeight;
 	break;
 	case LCD_Degrees_90:
 	case LCD_Degrees_270:
-		_width  = LCDHEIGHT;
-		_height = LCDWIDTH;
+		_width  = _bufferHeight;
+		_height = _bufferWidth;
 	break;
 	}
 	_LCD_rotate = CurrentRotation;